@@ -0,0 +1,110 @@
+// Local Headers
+#include "animation.hpp"
+#include "mesh.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Define Some Constants
+const int   kCharacters = 10000;
+const int   kJoints     = 64;
+const int   kFrames     = 100;
+const int   kVertices   = 4096;
+const float kTimestep   = 1.0f / 60.0f;
+
+// Time a Callable Over Several Frames, in Milliseconds per Frame
+template<typename F> double measure(F && frame)
+{
+    frame(); // Warm Up Thread Pools and Scratch Buffers
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; i++) frame();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / kFrames;
+}
+
+// Procedural Swing About One Axis, Phase-Shifted per Joint
+Mirage::Transform swing(int joint, float time, float speed)
+{
+    Mirage::Transform transform;
+    transform.translation = glm::vec3(0.0f, 1.0f, 0.0f);
+    transform.rotation = glm::angleAxis(0.5f * std::sin(speed * 6.2831853f * time + joint),
+                                        glm::vec3(1.0f, 0.0f, 0.0f));
+    transform.scale = glm::vec3(1.0f);
+    return transform;
+}
+
+int main(int argc, char * argv[]) {
+
+    // Allow a Smaller Crowd on Slow Machines
+    int count = argc > 1 ? std::atoi(argv[1]) : kCharacters;
+    if (count < 1) {
+        fprintf(stderr, "Usage: %s [characters >= 1, default %d]\n", argv[0], kCharacters);
+        return EXIT_FAILURE;
+    }
+
+    // Balanced Binary Tree of Joints, Similar in Depth to a Humanoid Rig
+    Mirage::Skeleton skeleton;
+    for (int i = 0; i < kJoints; i++)
+    {   int joint = skeleton.add("joint" + std::to_string(i), i == 0 ? -1 : (i - 1) / 2,
+                                 glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+        skeleton.bind(joint, glm::mat4(1.0f));
+    }
+
+    Mirage::Clip walk(skeleton, 1.0f, 30.0f, [](int joint, float time) { return swing(joint, time, 1.0f); });
+    Mirage::Clip run (skeleton, 0.6f, 30.0f, [](int joint, float time) { return swing(joint, time, 1.7f); });
+    fprintf(stdout, "clip: %d joints, %zu bytes quantized (%zu bytes as floats)\n",
+            kJoints, walk.bytes(), static_cast<std::size_t>(std::ceil(walk.duration() * 30.0f) + 1) * kJoints * sizeof(Mirage::Transform));
+
+    // Every Character Crossfades Between the Two Clips at its Own Phase
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Mirage::Character> characters(count);
+    for (auto & character : characters)
+    {
+        character.clips[0] = & walk;
+        character.clips[1] = & run;
+        character.times[0] = unit(random);
+        character.times[1] = unit(random);
+        character.weight   = unit(random);
+    }
+    auto advance = [&]()
+    {   for (auto & character : characters)
+        {   character.times[0] += kTimestep;
+            character.times[1] += kTimestep;
+        }
+    };
+
+    // Pose Evaluation on One Thread Versus All of Them
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    Mirage::Animator serial(1), parallel(threads);
+    double one = measure([&] { serial.update(skeleton, characters); advance(); });
+    double all = measure([&] { parallel.update(skeleton, characters); advance(); });
+    fprintf(stdout, "pose: %d characters, 1 thread %.3f ms/frame, %u threads %.3f ms/frame (%.1fx)\n",
+            count, one, threads, all, one / all);
+
+    // CPU Skinning Throughput for the Headless Path
+    std::vector<Mirage::Vertex> vertices(kVertices), skinned(kVertices);
+    std::vector<Mirage::Influence> influences(kVertices);
+    for (int i = 0; i < kVertices; i++)
+    {
+        vertices[i].position = glm::vec3(unit(random), unit(random), unit(random));
+        vertices[i].normal   = glm::vec3(0.0f, 1.0f, 0.0f);
+        vertices[i].uv       = glm::vec2(0.0f);
+        for (int k = 0; k < 4; k++) influences[i].bones[k] = (i + k * 17) % kJoints;
+        influences[i].weights = glm::vec4(0.4f, 0.3f, 0.2f, 0.1f);
+    }
+    double skin = measure([&]
+    {   Mirage::skin(vertices.data(), influences.data(), kVertices,
+                     characters[0].palette, skinned.data());
+    });
+    fprintf(stdout, "skin: %d vertices %.3f ms/frame (%.1f Mvertices/s)\n",
+            kVertices, skin, kVertices / skin / 1000.0);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+// Local Headers
+#include "geometry.hpp"
+#include "mesh.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+// Define Some Constants
+const int   kRuns     = 5;
+const int   kSegments = 512;
+const int   kLimit    = 4096;   // Keeps Triangle Counts and Indices Well Inside 32 Bits
+const int   kRings    = 256;
+const float kPi       = 3.14159265f;
+
+// Time a Callable Over Several Runs, in Milliseconds per Run
+template<typename F> double measure(F && run)
+{
+    run(); // Warm Up Allocators and Caches
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; i++) run();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / kRuns;
+}
+
+// UV Sphere as an OBJ Without Normals: the Seam Column Repeats Positions with Other UVs,
+// and Every Quad Touching a Pole Triangulates into One Collapsed Triangle
+std::string sphere(int segments, int rings)
+{
+    std::ostringstream obj;
+    for (int r = 0; r <= rings; r++)
+    for (int s = 0; s <= segments; s++)
+    {
+        float theta = kPi * r / rings, phi = 2.0f * kPi * (s % segments) / segments;
+        obj << "v "  << std::sin(theta) * std::cos(phi) << " " << std::cos(theta) << " "
+                     << std::sin(theta) * std::sin(phi) << "\n";
+        obj << "vt " << static_cast<float>(s) / segments << " " << 1.0f - static_cast<float>(r) / rings << "\n";
+    }
+    for (int r = 0; r < rings; r++)
+    for (int s = 0; s < segments; s++)
+    {
+        int a = r * (segments + 1) + s + 1, b = a + segments + 1;
+        obj << "f " << a << "/" << a << " " << a + 1 << "/" << a + 1 << " "
+            << b + 1 << "/" << b + 1 << " " << b << "/" << b << "\n";
+    }
+    return obj.str();
+}
+
+int main(int argc, char * argv[]) {
+
+    // Allow a Smaller Sphere on Slow Machines
+    int segments = argc > 1 ? std::atoi(argv[1]) : kSegments;
+    if (segments < 3 || segments > kLimit) {
+        fprintf(stderr, "Usage: %s [segments 3-%d, default %d]\n", argv[0], kLimit, kSegments);
+        return EXIT_FAILURE;
+    }
+    int rings    = std::max(2, segments / 2);
+    std::string obj = sphere(segments, rings);
+
+    // Full Assimp Preset Versus the Reduced Flags Followed by the Kernel
+    auto import = [&](Assimp::Importer & loader, unsigned int flags)
+    {   return loader.ReadFileFromMemory(obj.data(), obj.size(), flags, "obj");
+    };
+    double preset = measure([&]
+    {   Assimp::Importer loader;
+        import(loader, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_FlipUVs);
+    });
+    double reduced = measure([&]
+    {   Assimp::Importer loader;
+        aiScene const * scene = import(loader, Mirage::kImport);
+        std::vector<Mirage::Vertex> vertices;
+        std::vector<GLuint> indices;
+        if (scene) Mirage::Mesh::extract(scene->mMeshes[0], vertices, indices);
+    });
+    fprintf(stdout, "import: %d triangles, preset %.1f ms, reduced flags + kernel %.1f ms (%.1fx)\n",
+            2 * segments * rings, preset, reduced, preset / reduced);
+
+    // Flatten the Unwelded Corners Once, Then Time the Kernel Alone
+    Assimp::Importer loader;
+    aiScene const * scene = import(loader, Mirage::kImport);
+    if (!scene) { fprintf(stderr, "%s\n", loader.GetErrorString()); return EXIT_FAILURE; }
+    aiMesh const * mesh = scene->mMeshes[0];
+    std::vector<Mirage::Vertex> corners(mesh->mNumVertices);
+    std::vector<GLuint> triangles;
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+    {   corners[i].position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        corners[i].uv       = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+    for (unsigned int j = 0; j < mesh->mFaces[i].mNumIndices; j++)
+        triangles.push_back(mesh->mFaces[i].mIndices[j]);
+
+    Mirage::GeometryOptions options = { 0.0f, true, true, true };
+    Mirage::GeometryStats stats = {};
+    std::vector<Mirage::Vertex> vertices;
+    std::vector<GLuint> indices;
+    auto kernel = [&](Mirage::Geometry const & geometry)
+    {   vertices = corners;
+        indices  = triangles;
+        stats = geometry.process(vertices, indices, options);
+    };
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    Mirage::Geometry serial(1), parallel(threads);
+    double one = measure([&] { kernel(serial); });
+    double all = measure([&] { kernel(parallel); });
+    fprintf(stdout, "kernel: %zu corners, 1 thread %.1f ms, %u threads %.1f ms (%.1fx)\n",
+            corners.size(), one, threads, all, one / all);
+
+    // The Sphere's Exact Normal is its Position, so the Seam Must Not Show
+    float worst = 1.0f;
+    for (auto & vertex : vertices)
+        worst = std::min(worst, glm::dot(vertex.normal, glm::normalize(vertex.position)));
+    fprintf(stdout, "result: %zu welded, %zu degenerate, %zu vertices left, worst normal %.3f degrees off\n",
+            stats.welded, stats.degenerate, vertices.size(),
+            std::acos(std::min(worst, 1.0f)) * 180.0f / kPi);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+// Preprocessor Directives
+#ifndef SCHEDULER
+#define SCHEDULER
+#pragma once
+
+// Local Headers
+#include "glitter.hpp"
+
+// System Headers
+#include <GLFW/glfw3.h>
+
+// Standard Headers
+#include <vector>
+
+// Frame Pacing Options
+struct SchedulerConfig {
+    int    framesInFlight  = 2;          // Frames the CPU May Run Ahead of the GPU
+    bool   vsync           = true;
+    double targetFrameTime = 0.0;        // Seconds; Zero Disables Pacing
+    double gpuBudget       = 1.0 / 60.0; // Seconds of GPU Time Before Scaling Down
+    float  minScale        = 0.5f;       // Lowest Dynamic Resolution Scale
+};
+
+class Scheduler
+{
+public:
+
+    // Implement Custom Constructor and Destructor
+     Scheduler(GLFWwindow * window, SchedulerConfig const & config);
+    ~Scheduler();
+
+    // Bracket Every Frame; begin() Polls, Paces, Throttles and Polls Input Again
+    void begin();
+    void end();
+
+    // Called from Input Callbacks to Start a Latency Measurement
+    void input();
+
+    // Public Accessors
+    float  scale()     const { return mScale; }
+    double frameTime() const { return mFrameTime; }
+    double gpuTime()   const { return mGpuTime; }
+    double latency()   const { return mLatency; } // Event Poll to GPU Completion of its Frame
+
+private:
+
+    // Disable Copying and Assignment
+    Scheduler(Scheduler const &) = delete;
+    Scheduler & operator=(Scheduler const &) = delete;
+
+    // Private Member Functions
+    void pace();
+    void retire(int slot, GLuint64 timeout);
+
+    // Per-Frame Slots, One per Frame in Flight
+    std::vector<GLsync> mFences;
+    std::vector<GLuint> mQueries;
+    std::vector<double> mInputs;
+
+    // Private Member Variables
+    GLFWwindow * mWindow;
+    SchedulerConfig mConfig;
+    int    mSlot;
+    double mPending;
+    double mDeadline;
+    double mLastFrame;
+    double mFrameTime;
+    double mGpuTime;
+    double mLatency;
+    float  mScale;
+
+};
+
+#endif //~ Scheduler Header
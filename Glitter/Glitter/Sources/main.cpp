@@ -1,5 +1,6 @@
 // Local Headers
 #include "glitter.hpp"
+#include "scheduler.hpp"
 #include "shader.h"
 #include <iostream>
 
@@ -10,6 +11,7 @@
 // Standard Headers
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode)
 {
@@ -17,6 +19,10 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     // closing the application
     if(key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(window, GL_TRUE);
+
+    // Every input event starts a latency measurement, from this poll to its frame leaving the GPU
+    auto scheduler = static_cast<Scheduler *>(glfwGetWindowUserPointer(window));
+    if (scheduler) scheduler->input();
 }
 
 int main(int argc, char * argv[]) {
@@ -58,6 +64,27 @@ int main(int argc, char * argv[]) {
     
     glfwSetKeyCallback(window, key_callback);
     
+    // Pace frames and keep at most two frames in flight
+    SchedulerConfig config;
+    config.framesInFlight = 2;
+    config.targetFrameTime = 1.0 / 60.0;
+    std::unique_ptr<Scheduler> scheduler(new Scheduler(window, config));
+    glfwSetWindowUserPointer(window, scheduler.get());
+    
+    // Offscreen target so dynamic resolution can render to a smaller viewport
+    GLuint FBO0, RBO0, RBO1;
+    glGenFramebuffers(1, &FBO0);
+    glGenRenderbuffers(1, &RBO0);
+    glBindRenderbuffer(GL_RENDERBUFFER, RBO0);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &RBO1);
+    glBindRenderbuffer(GL_RENDERBUFFER, RBO1);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, RBO0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, RBO1);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
     Shader shaderProgram("shader.vs", "shader.frag");
     
     GLuint VAO0;
@@ -96,15 +123,23 @@ int main(int argc, char * argv[]) {
     
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glEnable(GL_DEPTH_TEST);
     
     // Rendering Loop
+    double report = glfwGetTime();
     while (glfwWindowShouldClose(window) == false)
     {
-        glfwPollEvents();
+        scheduler->begin();
+        
+        // Render at the scaled resolution chosen by the scheduler
+        int scaledWidth  = static_cast<int>(width  * scheduler->scale());
+        int scaledHeight = static_cast<int>(height * scheduler->scale());
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO0);
+        glViewport(0, 0, scaledWidth, scaledHeight);
         
         // Background Fill Color
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         glUniform1f(glGetUniformLocation(shaderProgram.Program, "offset"), 0.5);
         shaderProgram.Use();
@@ -112,11 +147,32 @@ int main(int argc, char * argv[]) {
         glBindVertexArray(VAO0);
         glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
+        
+        // Upscale into the window
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, scaledWidth, scaledHeight, 0, 0, width, height,
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // Flip Buffers and Draw
-        glfwSwapBuffers(window);
+        scheduler->end();
+        
+        if (glfwGetTime() - report > 1.0)
+        {
+            report = glfwGetTime();
+            fprintf(stderr, "frame %.2f ms, gpu %.2f ms, latency %.2f ms, scale %.2f\n",
+                    scheduler->frameTime() * 1000.0, scheduler->gpuTime() * 1000.0,
+                    scheduler->latency() * 1000.0, scheduler->scale());
+        }
     }
     
+    glfwSetWindowUserPointer(window, nullptr);
+    scheduler.reset();
+    glDeleteFramebuffers(1, &FBO0);
+    glDeleteRenderbuffers(1, &RBO0);
+    glDeleteRenderbuffers(1, &RBO1);
+    
     glfwTerminate();
     
     return EXIT_SUCCESS;
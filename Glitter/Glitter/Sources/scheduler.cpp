@@ -0,0 +1,119 @@
+// Local Headers
+#include "scheduler.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Define Some Constants
+const double kSmoothing  = 0.1;   // Weight of Each New Sample in the Running Averages
+
+Scheduler::Scheduler(GLFWwindow * window, SchedulerConfig const & config)
+    : mFences(std::max(1, config.framesInFlight), nullptr)
+    , mQueries(mFences.size())
+    , mInputs(mFences.size(), -1.0)
+    , mWindow(window)
+    , mConfig(config)
+    , mSlot(0)
+    , mPending(-1.0)
+    , mDeadline(glfwGetTime())
+    , mLastFrame(mDeadline)
+    , mFrameTime(0.0)
+    , mGpuTime(0.0)
+    , mLatency(0.0)
+    , mScale(1.0f)
+{
+    glfwSwapInterval(config.vsync ? 1 : 0);
+    glGenQueries(mQueries.size(), mQueries.data());
+}
+
+Scheduler::~Scheduler()
+{
+    for (unsigned int i = 0; i < mFences.size(); i++)
+        if (mFences[i]) glDeleteSync(mFences[i]);
+    glDeleteQueries(mQueries.size(), mQueries.data());
+}
+
+void Scheduler::begin()
+{
+    // Stamp Events That Arrived During the Last Frame, So the Pacing Wait Counts Toward
+    // Their Latency, Then Sleep and Poll Again so Input is Sampled as Late as Possible
+    glfwPollEvents();
+    pace();
+
+    // Block Until the Frame That Last Used This Slot Has Left the GPU
+    retire(mSlot, GL_TIMEOUT_IGNORED);
+
+    glfwPollEvents();
+    mInputs[mSlot] = mPending;
+    mPending = -1.0;
+    glBeginQuery(GL_TIME_ELAPSED, mQueries[mSlot]);
+}
+
+void Scheduler::end()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    glfwSwapBuffers(mWindow);
+    mFences[mSlot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    // Opportunistically Retire Other Slots for More Accurate Latency Samples
+    mSlot = (mSlot + 1) % mFences.size();
+    for (unsigned int i = 0; i < mFences.size(); i++)
+        if (static_cast<int>(i) != mSlot) retire(i, 0);
+
+    double now = glfwGetTime();
+    mFrameTime = (1.0 - kSmoothing) * mFrameTime + kSmoothing * (now - mLastFrame);
+    mLastFrame = now;
+}
+
+void Scheduler::input()
+{
+    // Keep the Earliest Event Since the Last Poll
+    if (mPending < 0.0) mPending = glfwGetTime();
+}
+
+void Scheduler::pace()
+{
+    if (mConfig.targetFrameTime <= 0.0) return;
+
+    // Sleep Straight to the Deadline; Waking Slightly Late Costs Less Than Spinning a Core
+    mDeadline += mConfig.targetFrameTime;
+    double remaining = mDeadline - glfwGetTime();
+    if (remaining > 0.0)
+        std::this_thread::sleep_until(std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(remaining)));
+
+    // Resynchronize Instead of Bursting After a Long Stall
+    double now = glfwGetTime();
+    if (now - mDeadline > mConfig.targetFrameTime) mDeadline = now;
+}
+
+void Scheduler::retire(int slot, GLuint64 timeout)
+{
+    if (!mFences[slot]) return;
+    GLenum status = glClientWaitSync(mFences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) return;
+    glDeleteSync(mFences[slot]);
+    mFences[slot] = nullptr;
+
+    // The Fence Follows the Swap, so This Measures From the Poll That First Saw the Event
+    // to the Frame Leaving the GPU; OS Queueing and Scanout are Not Included
+    double now = glfwGetTime();
+    if (mInputs[slot] >= 0.0)
+        mLatency = (1.0 - kSmoothing) * mLatency + kSmoothing * (now - mInputs[slot]);
+    mInputs[slot] = -1.0;
+
+    // Timer Results are Ready Once the Fence Has Signaled
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(mQueries[slot], GL_QUERY_RESULT, & elapsed);
+    mGpuTime = (1.0 - kSmoothing) * mGpuTime + kSmoothing * (elapsed * 1e-9);
+
+    // Trade Resolution for Frame Time When the GPU Runs Over Budget
+    if (mGpuTime > mConfig.gpuBudget)
+        mScale = std::max(mConfig.minScale, mScale * 0.95f);
+    else if (mGpuTime < mConfig.gpuBudget * 0.8)
+        mScale = std::min(1.0f, mScale + 0.01f);
+}
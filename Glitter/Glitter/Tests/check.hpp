@@ -0,0 +1,13 @@
+#pragma once
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+
+// Track Failures Without Stopping at the First One; Each Test is a Single Translation Unit
+static int failures = 0;
+static void check(bool condition, char const * name)
+{
+    fprintf(condition ? stdout : stderr, "%s %s\n", condition ? "pass" : "FAIL", name);
+    if (!condition) failures++;
+}
@@ -0,0 +1,45 @@
+// Local Headers
+#include "check.hpp"
+#include "image.hpp"
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+
+// Solid Background with a Filled Square, Optionally Offset
+static Image square(int offset, unsigned char shade)
+{
+    Image image = { 64, 64, std::vector<unsigned char>(64 * 64 * 4, 255) };
+    for (int y = 16; y < 48; y++)
+    for (int x = 16 + offset; x < 48 + offset; x++)
+    {   unsigned char * pixel = & image.rgba[(y * 64 + x) * 4];
+        pixel[0] = shade; pixel[1] = 0; pixel[2] = 0;
+    }
+    return image;
+}
+
+int main() {
+
+    // Identical Images Match Exactly
+    Difference same = compare(square(0, 200), square(0, 200), 0, 2.3f);
+    check(same.max == 0.0f && same.fraction == 0.0f, "identical images match");
+
+    // A One Pixel Shift Along an Edge is Tolerated Only Within the Radius
+    check(compare(square(0, 200), square(1, 200), 1, 2.3f).fraction == 0.0f, "edge shift within radius");
+    check(compare(square(0, 200), square(1, 200), 0, 2.3f).fraction >  0.0f, "edge shift without radius");
+
+    // Barely Visible Shade Changes Pass, Obvious Ones Do Not
+    check(compare(square(0, 200), square(0, 201), 1, 2.3f).fraction == 0.0f, "imperceptible shade");
+    check(compare(square(0, 200), square(0, 120), 1, 2.3f).fraction >  0.2f, "visible shade");
+
+    // Missing Geometry is Caught in Either Direction
+    Image empty = { 64, 64, std::vector<unsigned char>(64 * 64 * 4, 255) };
+    check(compare(square(0, 200), empty, 1, 2.3f).fraction > 0.2f, "missing feature");
+    check(compare(empty, square(0, 200), 1, 2.3f).fraction > 0.2f, "extra feature");
+
+    // Mismatched Sizes Never Pass
+    Image small = { 32, 32, std::vector<unsigned char>(32 * 32 * 4, 255) };
+    check(compare(empty, small, 1, 2.3f).fraction == 1.0f, "size mismatch");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
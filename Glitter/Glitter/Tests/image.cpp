@@ -0,0 +1,103 @@
+// Preprocessor Directives
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+// Local Headers
+#include "image.hpp"
+
+// System Headers
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Convert an 8-Bit sRGB Color to CIELAB Under a D65 White Point
+static void lab(unsigned char const * rgb, float * out)
+{
+    float linear[3];
+    for (int i = 0; i < 3; i++)
+    {   float c = rgb[i] / 255.0f;
+        linear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+    float xyz[3] = {
+        (0.4124f * linear[0] + 0.3576f * linear[1] + 0.1805f * linear[2]) / 0.95047f,
+        (0.2126f * linear[0] + 0.7152f * linear[1] + 0.0722f * linear[2]),
+        (0.0193f * linear[0] + 0.1192f * linear[1] + 0.9505f * linear[2]) / 1.08883f,
+    };
+    for (int i = 0; i < 3; i++)
+        xyz[i] = xyz[i] > 0.008856f ? std::cbrt(xyz[i]) : 7.787f * xyz[i] + 16.0f / 116.0f;
+    out[0] = 116.0f * xyz[1] - 16.0f;
+    out[1] = 500.0f * (xyz[0] - xyz[1]);
+    out[2] = 200.0f * (xyz[1] - xyz[2]);
+}
+
+bool load(std::string const & filename, Image & image)
+{
+    int channels;
+    unsigned char * pixels = stbi_load(filename.c_str(), & image.width, & image.height, & channels, 4);
+    if (!pixels) return false;
+    image.rgba.assign(pixels, pixels + image.width * image.height * 4);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool save(std::string const & filename, Image const & image)
+{
+    return stbi_write_png(filename.c_str(), image.width, image.height, 4,
+                          image.rgba.data(), image.width * 4) != 0;
+}
+
+Difference compare(Image const & expected, Image const & actual,
+                   int radius, float threshold)
+{
+    Difference difference;
+    difference.map = actual;
+    if (expected.width != actual.width || expected.height != actual.height)
+    {   difference.mean = difference.max = std::numeric_limits<float>::infinity();
+        difference.fraction = 1.0f;
+        return difference;
+    }
+
+    // Convert Both Images Once Up Front
+    int width = actual.width, height = actual.height;
+    std::vector<float> a(width * height * 3), b(width * height * 3);
+    for (int i = 0; i < width * height; i++)
+    {   lab(& expected.rgba[i * 4], & a[i * 3]);
+        lab(& actual.rgba[i * 4],   & b[i * 3]);
+    }
+
+    // Closest Match for a Pixel of One Image within the Radius in the Other
+    auto nearest = [&](std::vector<float> const & from, std::vector<float> const & to, int x, int y)
+    {   float best = std::numeric_limits<float>::max();
+        float const * color = & from[(y * width + x) * 3];
+        for (int j = std::max(0, y - radius); j <= std::min(height - 1, y + radius); j++)
+        for (int i = std::max(0, x - radius); i <= std::min(width - 1,  x + radius); i++)
+        {   float const * other = & to[(j * width + i) * 3];
+            float dl = color[0] - other[0], da = color[1] - other[1], db = color[2] - other[2];
+            best = std::min(best, dl * dl + da * da + db * db);
+        }   return std::sqrt(best);
+    };
+
+    // Check Both Directions so Features Missing from Either Image are Caught
+    double total = 0.0; int failing = 0;
+    difference.max = 0.0f;
+    for (int y = 0; y < height; y++)
+    for (int x = 0; x < width;  x++)
+    {
+        float delta = std::max(nearest(a, b, x, y), nearest(b, a, x, y));
+        total += delta;
+        difference.max = std::max(difference.max, delta);
+        unsigned char * pixel = & difference.map.rgba[(y * width + x) * 4];
+        if (delta > threshold)
+        {   failing++;
+            pixel[0] = 255; pixel[1] = pixel[2] = 0;
+        }
+        else for (int c = 0; c < 3; c++) pixel[c] /= 4;
+        pixel[3] = 255;
+    }
+    difference.mean = static_cast<float>(total / (width * height));
+    difference.fraction = static_cast<float>(failing) / (width * height);
+    return difference;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Standard Headers
+#include <string>
+#include <vector>
+
+// Tightly Packed 8-Bit RGBA, Top Row First
+struct Image {
+    int width;
+    int height;
+    std::vector<unsigned char> rgba;
+};
+
+// Result of Comparing Two Images in CIELAB Space
+struct Difference {
+    float mean;      // Average Delta E over All Pixels
+    float max;       // Worst Single Pixel
+    float fraction;  // Share of Pixels Whose Delta E Exceeds the Threshold
+    Image map;       // Failing Pixels in Red, Useful When Reviewing a Failure
+};
+
+// Read and Write PNG Files; Return False on Failure
+bool load(std::string const & filename, Image & image);
+bool save(std::string const & filename, Image const & image);
+
+// Per-Pixel Delta E, Allowing Each Pixel to Match Anywhere within a Small Radius so
+// Rasterization Differences Between Drivers Along Edges are Not Reported
+Difference compare(Image const & expected, Image const & actual,
+                   int radius, float threshold);
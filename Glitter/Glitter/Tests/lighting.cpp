@@ -0,0 +1,103 @@
+// Local Headers
+#include "check.hpp"
+#include "lighting.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Define Some Constants
+const int   kTilesX = 16, kTilesY = 9, kSlices = 24;
+const int   kWidth  = 1600, kHeight = 900;
+const float kNear   = 0.1f, kFar = 100.0f;
+
+// Lights Touching Each Cluster, Sorted so Orderings Can be Compared
+static std::vector<std::vector<GLuint>> gather(Mirage::Lighting const & lighting)
+{
+    std::vector<std::vector<GLuint>> lists;
+    for (auto & cluster : lighting.clusters())
+    {   std::vector<GLuint> list(lighting.indices().begin() + cluster.offset,
+                                 lighting.indices().begin() + cluster.offset + cluster.count);
+        std::sort(list.begin(), list.end());
+        lists.push_back(list);
+    }   return lists;
+}
+
+int main() {
+
+    // Lights are Given in View Space, so the Camera Sits at the Origin Looking Down -z
+    Mirage::Lighting lighting(kTilesX, kTilesY, kSlices);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), float(kWidth) / kHeight, kNear, kFar);
+    glm::mat4 view(1.0f);
+    lighting.resize(projection, kNear, kFar, kWidth, kHeight);
+
+    // Deterministic Scatter; the Count Leaves a Partial Group of Four for the Scalar Tail
+    std::vector<Mirage::Light> lights;
+    unsigned int seed = 12345;
+    auto random = [&](float lo, float hi)
+    {   seed = seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * (seed >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < 37; i++)
+    {   Mirage::Light light = { glm::vec3(random(-20.0f, 20.0f), random(-10.0f, 10.0f), random(-90.0f, -1.0f)),
+                                random(0.5f, 5.0f), glm::vec3(1.0f), 1.0f, 0 };
+        lights.push_back(light);
+    }
+    lighting.assign(lights, view);
+    auto batched = gather(lighting);
+
+    // Clusters Tile the Index List Exactly, and Padding Lanes Never Leak Into it
+    std::size_t offset = 0; bool contiguous = true, bounded = true;
+    for (auto & cluster : lighting.clusters())
+    {   contiguous = contiguous && cluster.offset == offset;
+        offset += cluster.count;
+    }
+    for (auto index : lighting.indices()) bounded = bounded && index < lights.size();
+    check(contiguous && offset == lighting.indices().size(), "clusters tile the index list");
+    check(bounded, "padding lanes are never assigned");
+
+    // Every Light Reaches the Cluster Holding its Center
+    bool centered = true;
+    float tileX = std::ceil(float(kWidth) / kTilesX), tileY = std::ceil(float(kHeight) / kTilesY);
+    for (std::size_t i = 0; i < lights.size(); i++)
+    {
+        glm::vec4 clip = projection * glm::vec4(lights[i].position, 1.0f);
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        if (std::fabs(ndc.x) >= 1.0f || std::fabs(ndc.y) >= 1.0f) continue;
+        int x = static_cast<int>((ndc.x * 0.5f + 0.5f) * kWidth  / tileX);
+        int y = static_cast<int>((ndc.y * 0.5f + 0.5f) * kHeight / tileY);
+        int z = static_cast<int>(std::log(-lights[i].position.z / kNear) * kSlices / std::log(kFar / kNear));
+        auto & list = batched[lighting.cluster(x, y, std::min(z, kSlices - 1))];
+        centered = centered && std::binary_search(list.begin(), list.end(), GLuint(i));
+    }
+    check(centered, "lights reach the cluster holding their center");
+
+    // Four Lights at a Time Must Agree With Each Light Assigned Alone
+    std::vector<std::vector<GLuint>> single(batched.size());
+    for (std::size_t i = 0; i < lights.size(); i++)
+    {   lighting.assign(std::vector<Mirage::Light>(1, lights[i]), view);
+        for (std::size_t c = 0; c < single.size(); c++)
+            if (lighting.clusters()[c].count > 0) single[c].push_back(i);
+    }
+    check(single == batched, "batched assignment matches lights assigned one at a time");
+
+    // Lights Entirely Behind the Camera or Past the Far Plane Touch No Cluster
+    Mirage::Light behind = { glm::vec3(0.0f, 0.0f,    5.0f), 1.0f, glm::vec3(1.0f), 1.0f, 0 };
+    Mirage::Light beyond = { glm::vec3(0.0f, 0.0f, -120.0f), 5.0f, glm::vec3(1.0f), 1.0f, 0 };
+    std::vector<Mirage::Light> outside = { behind, beyond };
+    lighting.assign(outside, view);
+    check(lighting.indices().empty(), "lights outside the depth range are skipped");
+
+    // Moving the Camera Moves the Lights into View Space
+    Mirage::Light ahead = { glm::vec3(0.0f, 0.0f, -10.0f), 1.0f, glm::vec3(1.0f), 1.0f, 0 };
+    lighting.assign(std::vector<Mirage::Light>(1, ahead), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -95.0f)));
+    check(lighting.indices().empty(), "lights are culled after the view transform");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,70 @@
+// Local Headers
+#include "check.hpp"
+#include "occlusion.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+
+// Axis-Aligned Box Test in World Space
+static bool box(Mirage::Occlusion & occlusion, glm::vec3 const & min, glm::vec3 const & max)
+{
+    return occlusion.visible(min, max, glm::mat4(1.0f));
+}
+
+int main() {
+
+    // Camera at the Origin Looking Down -z; the CPU Path Never Touches the GPU
+    Mirage::Occlusion occlusion(256, 128);
+    occlusion.begin(glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f));
+
+    // Nothing Rasterized Yet, so Nothing Can be Hidden
+    occlusion.clear();
+    occlusion.build();
+    check(box(occlusion, glm::vec3(-0.5f, -0.5f, -10.0f), glm::vec3(0.5f, 0.5f, -9.0f)), "empty buffer hides nothing");
+
+    // A Wall Quad Four Units Wide, Five Units Away
+    glm::vec3 quad[] = { glm::vec3(-2.0f, -2.0f, -5.0f), glm::vec3( 2.0f, -2.0f, -5.0f),
+                         glm::vec3( 2.0f,  2.0f, -5.0f), glm::vec3(-2.0f,  2.0f, -5.0f) };
+    GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+    occlusion.clear();
+    occlusion.rasterize(quad, sizeof(glm::vec3), indices, 6, glm::mat4(1.0f));
+    occlusion.build();
+    check(occlusion.depth(0, 128, 64) < 1.0f, "quad covers the center");
+    check(occlusion.depth(0, 2, 2) == 1.0f, "quad leaves the corner empty");
+
+    // Behind the Wall is Culled; in Front of it or Beside it is Drawn
+    check(!box(occlusion, glm::vec3(-0.5f, -0.5f, -10.0f), glm::vec3(0.5f, 0.5f, -9.0f)), "box behind occluder is culled");
+    check( box(occlusion, glm::vec3(-0.5f, -0.5f,  -3.0f), glm::vec3(0.5f, 0.5f, -2.0f)), "box in front of occluder is visible");
+    check( box(occlusion, glm::vec3(-1.0f, -1.0f,  -6.0f), glm::vec3(1.0f, 1.0f, -4.0f)), "box straddling occluder is visible");
+    check( box(occlusion, glm::vec3( 6.0f, -0.5f, -10.0f), glm::vec3(7.0f, 0.5f, -9.0f)), "box beside occluder is visible");
+    check(!box(occlusion, glm::vec3(50.0f, -0.5f, -10.0f), glm::vec3(51.0f, 0.5f, -9.0f)), "box outside frustum is culled");
+
+    // Counters Follow the Tests Above
+    auto const & stats = occlusion.stats();
+    check(stats.tested == 6 && stats.culled + stats.drawn == stats.tested, "stats add up");
+
+    // Rasterizing the Same Occluders Again Gives the Same Buffer
+    float center = occlusion.depth(0, 128, 64);
+    occlusion.clear();
+    occlusion.rasterize(quad, sizeof(glm::vec3), indices, 6, glm::mat4(1.0f));
+    occlusion.build();
+    check(occlusion.depth(0, 128, 64) == center, "rasterization is deterministic");
+
+    // Stepping Sideways Past the Wall Reveals a Box the Old Depth Still Hides
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+    glm::vec3 hiddenMin(2.0f, -0.5f, -10.0f), hiddenMax(2.5f, 0.5f, -9.0f);
+    check(!box(occlusion, hiddenMin, hiddenMax), "box hidden from the capturing camera is culled");
+    occlusion.begin(projection * glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f, 0.0f, 0.0f)));
+    check( box(occlusion, hiddenMin, hiddenMax), "box revealed by a camera move is visible");
+    check(!box(occlusion, glm::vec3(50.0f, -0.5f, -10.0f), glm::vec3(51.0f, 0.5f, -9.0f)), "frustum still culls after a camera move");
+
+    // Returning to the Capturing Camera Trusts the Pyramid Again
+    occlusion.begin(projection);
+    check(!box(occlusion, hiddenMin, hiddenMax), "unmoved camera culls against the pyramid");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
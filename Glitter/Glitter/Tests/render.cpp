@@ -0,0 +1,499 @@
+// Local Headers
+#include "image.hpp"
+#include "lighting.hpp"
+#include "mesh.hpp"
+#include "passes.hpp"
+#include "shader.hpp"
+#include "shadows.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+
+// Define Some Constants
+const int    kSize       = 256;    // Square Render Target for Every Scene
+const int    kSkip       = 77;     // Matches SKIP_RETURN_CODE in CMakeLists.txt
+const int    kWarmUp     = 10;
+const int    kFrames     = 200;
+const int    kRadius     = 1;      // Pixels a Feature May Move Between Drivers
+const float  kDeltaE     = 3.0f;   // Just Above a Noticeable Color Difference
+const float  kFraction   = 0.001f; // Share of Pixels Allowed to Exceed kDeltaE
+const double kRegression = 0.25;   // Allowed Slowdown or Growth Against the Baseline
+
+// A Scene Creates its GL Objects Once, then Draws One Frame per Call
+typedef std::function<void()> Frame;
+
+// Per-Scene Measurements Stored in the Baseline
+struct Metrics {
+    double cpu;   // Milliseconds per Frame, Including glFinish
+    double gpu;   // Milliseconds per Frame from Timer Queries
+    double rss;   // Peak Resident Set, in Kilobytes
+};
+
+// Compile a Program from Source, Reporting Errors Like Mirage::Shader
+GLuint program(std::string const & vertex, std::string const & fragment)
+{
+    GLuint program = glCreateProgram();
+    auto attach = [program](GLenum type, std::string const & source)
+    {   GLuint shader = glCreateShader(type);
+        char const * text = source.c_str();
+        glShaderSource(shader, 1, & text, nullptr);
+        glCompileShader(shader);
+        GLint status; glGetShaderiv(shader, GL_COMPILE_STATUS, & status);
+        if (status == GL_FALSE)
+        {   char log[1024]; glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            fprintf(stderr, "%s\n", log);
+        }
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+    };
+    attach(GL_VERTEX_SHADER, vertex);
+    attach(GL_FRAGMENT_SHADER, fragment);
+    glLinkProgram(program);
+    return program;
+}
+
+// Create a Directory if it is Missing, so --update and --record Work on a Fresh Checkout
+void directory(std::string const & path)
+{
+#if defined(_WIN32)
+    CreateDirectoryA(path.c_str(), nullptr);
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+// Read a Whole Text File
+std::string slurp(std::string const & filename)
+{
+    std::ifstream fd(filename);
+    std::stringstream buffer; buffer << fd.rdbuf();
+    if (!fd) fprintf(stderr, "%s %s\n", "Failed to Open", filename.c_str());
+    return buffer.str();
+}
+
+// Lambert Shading Shared by the Mesh Scenes; Textured Scenes Sample "diffuse"
+const char * kMeshVertex = R"(
+    #version 330 core
+    layout (location = 0) in vec3 position;
+    layout (location = 1) in vec3 normal;
+    layout (location = 2) in vec2 uv;
+    uniform mat4 model;
+    uniform mat4 viewProjection;
+    out vec3 worldNormal;
+    out vec2 texCoord;
+    void main()
+    {
+        worldNormal = mat3(model) * normal;
+        texCoord    = uv;
+        gl_Position = viewProjection * model * vec4(position, 1.0);
+    })";
+const char * kMeshFragment = R"(
+    #version 330 core
+    uniform sampler2D diffuse;
+    uniform bool textured;
+    in vec3 worldNormal;
+    in vec2 texCoord;
+    out vec4 color;
+    void main()
+    {
+        vec3 albedo = textured ? texture(diffuse, texCoord).rgb : vec3(0.8);
+        float light = max(dot(normalize(worldNormal), normalize(vec3(0.4, 0.8, 0.6))), 0.0);
+        color = vec4(albedo * (0.2 + 0.8 * light), 1.0);
+    })";
+
+// The Triangle Drawn by main.cpp, with the Same Shaders and Clear Color
+Frame triangle()
+{
+    GLuint shader = program(slurp(PROJECT_SOURCE_DIR "/Glitter/Sources/shader.vs"),
+                            slurp(PROJECT_SOURCE_DIR "/Glitter/Sources/shader.frag"));
+    GLfloat vertices[] = {
+        -0.25f, -0.25f, 0.0f,    1.0f, 0.0f, 0.0f,
+         0.00f,  0.50f, 0.0f,    0.0f, 1.0f, 0.0f,
+         0.25f, -0.25f, 0.0f,    0.0f, 0.0f, 1.0f,
+    };
+    GLuint indices[] = { 0, 1, 2 };
+    GLuint vertexArray, buffers[2];
+    glGenVertexArrays(1, & vertexArray);
+    glGenBuffers(2, buffers);
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *) 0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *) (3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    return [=]()
+    {   glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glUseProgram(shader);
+        glUniform1f(glGetUniformLocation(shader, "offset"), 0.5f);
+        glBindVertexArray(vertexArray);
+        glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    };
+}
+
+// A Model Loaded Through Assimp and Mirage::Mesh, Viewed from a Fixed Camera
+Frame model(std::string const & filename, bool textured, glm::mat4 const & transform)
+{
+    GLuint shader = program(kMeshVertex, kMeshFragment);
+    std::shared_ptr<Mirage::Mesh> mesh(new Mirage::Mesh(filename));
+    glm::mat4 viewProjection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 10.0f)
+                             * glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return [=]()
+    {   glEnable(GL_DEPTH_TEST);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glUseProgram(shader);
+        glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, & transform[0][0]);
+        glUniformMatrix4fv(glGetUniformLocation(shader, "viewProjection"), 1, GL_FALSE, & viewProjection[0][0]);
+        glUniform1i(glGetUniformLocation(shader, "textured"), textured);
+        mesh->draw(shader);
+        glDisable(GL_DEPTH_TEST);
+    };
+}
+
+// Scenes May Print Extra Metrics Once Timing is Done
+std::function<void()> report;
+
+// Layers of Spheres Behind Glass, Drawn Through Mirage::Passes; Needs OpenGL 4.3
+Frame overdraw()
+{
+    GLuint shader = program(kMeshVertex, kMeshFragment);
+    std::shared_ptr<Mirage::Shader> glass(new Mirage::Shader());
+    glass->attach("clustered.vert").attach("transparent.frag").link();
+    std::shared_ptr<Mirage::Mesh> sphere(new Mirage::Mesh("Tests/sphere.obj"));
+    std::shared_ptr<Mirage::Mesh> cube(new Mirage::Mesh("Tests/cube.obj"));
+    std::shared_ptr<Mirage::Passes> passes(new Mirage::Passes(kSize, kSize));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 20.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 6.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 viewProjection = projection * view;
+
+    // Opaque Layers are Submitted Back to Front, the Worst Case for Forward Shading
+    std::vector<Mirage::Renderable> renderables;
+    for (int z = 3; z >= 0; z--)
+    for (int y = -2; y <= 2; y++)
+    for (int x = -2; x <= 2; x++)
+    {   glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x * 0.8f, y * 0.8f, z * -1.5f));
+        Mirage::Renderable renderable = { sphere.get(), glm::scale(model, glm::vec3(0.6f)), glm::vec4(1.0f) };
+        renderables.push_back(renderable);
+    }
+    glm::vec4 tints[3] = { glm::vec4(1.0f, 0.2f, 0.2f, 0.4f), glm::vec4(0.2f, 1.0f, 0.2f, 0.4f), glm::vec4(0.2f, 0.2f, 1.0f, 0.4f) };
+    for (int i = 0; i < 3; i++)
+    {   glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(i * 0.6f - 0.6f, 0.0f, 1.0f + i * 0.4f));
+        Mirage::Renderable renderable = { cube.get(), model, tints[i] };
+        renderables.push_back(renderable);
+    }
+
+    auto frame = [=]()
+    {   // Renderables Hold Raw Pointers; Capturing the Meshes Keeps Them Alive
+        (void) sphere; (void) cube;
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        GLint target; glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, & target);
+        glUseProgram(shader);
+        glUniformMatrix4fv(glGetUniformLocation(shader, "viewProjection"), 1, GL_FALSE, & viewProjection[0][0]);
+        glUniform1i(glGetUniformLocation(shader, "textured"), 0);
+        glass->activate().bind("view", view).bind("projection", projection);
+        passes->render(target, viewProjection, shader, glass->get(), renderables);
+        glDisable(GL_DEPTH_TEST);
+    };
+
+    // Compare Fragments Shaded With and Without the Pre-Pass
+    report = [=]()
+    {   passes->measure(true);
+        Mirage::PassMode modes[2] = { Mirage::PassForward, Mirage::PassDepthPrepass };
+        char const * names[2] = { "forward", "prepass" };
+        for (int i = 0; i < 2; i++)
+        {   passes->mode(modes[i]);
+            frame();
+            auto & stats = passes->stats();
+            fprintf(stdout, "overdraw %s: %.2f shaded per pixel (%llu depth, %llu opaque, %llu transparent fragments)\n",
+                    names[i], stats.overdraw, static_cast<unsigned long long>(stats.prepass),
+                    static_cast<unsigned long long>(stats.opaque), static_cast<unsigned long long>(stats.transparent));
+        }
+        passes->measure(false);
+    };
+    return frame;
+}
+
+// A Sphere Over a Floor, Lit by a Shadowed Point Light Through clustered.frag; Needs OpenGL 4.3
+Frame shadows()
+{
+    std::shared_ptr<Mirage::Shader> shader(new Mirage::Shader());
+    shader->attach("clustered.vert").attach("clustered.frag").link();
+    std::shared_ptr<Mirage::Mesh> sphere(new Mirage::Mesh("Tests/sphere.obj"));
+    std::shared_ptr<Mirage::Mesh> cube(new Mirage::Mesh("Tests/cube.obj"));
+    std::shared_ptr<Mirage::Lighting> lighting(new Mirage::Lighting());
+    std::shared_ptr<Mirage::Shadows> shadows(new Mirage::Shadows(1024));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 20.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 3.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    lighting->resize(projection, 0.1f, 20.0f, kSize, kSize);
+
+    // The Lamp Shadows Through the First Six Views Declared Each Frame
+    glm::vec3 lamp(1.0f, 2.5f, 0.5f);
+    Mirage::Light light = { lamp, 8.0f, glm::vec3(1.0f), 2.0f, 1 };
+    std::vector<Mirage::Light> lights(1, light);
+    glm::mat4 ball  = glm::scale(glm::mat4(1.0f), glm::vec3(0.6f));
+    glm::mat4 floor = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
+                                 glm::vec3(3.0f, 0.1f, 3.0f));
+    std::vector<Mirage::ShadowCaster> casters = { { sphere.get(), ball, false }, { cube.get(), floor, false } };
+
+    // Untextured Meshes Sample a White Texel
+    GLuint white; unsigned char texel[4] = { 255, 255, 255, 255 };
+    glGenTextures(1, & white);
+    glBindTexture(GL_TEXTURE_2D, white);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    return [=]()
+    {   glEnable(GL_DEPTH_TEST);
+        shadows->begin();
+        for (int face = 0; face < 6; face++) shadows->point(lamp, 8.0f, face, 256);
+        shadows->render(casters);
+
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        shader->activate().bind("view", view).bind("projection", projection);
+        lighting->assign(lights, view);
+        lighting->bind(shader->get());
+        shadows->bind(shader->get(), 15);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, white);
+        glUniform1i(glGetUniformLocation(shader->get(), "diffuse"), 0);
+        glUniform1i(glGetUniformLocation(shader->get(), "specular"), 0);
+        shader->bind("model", ball);
+        sphere->draw(shader->get());
+        shader->bind("model", floor);
+        cube->draw(shader->get());
+        glDisable(GL_DEPTH_TEST);
+    };
+}
+
+// Every Reference Scene, by the Name Used for Goldens, the Baseline and CTest
+std::map<std::string, std::function<Frame()>> scenes()
+{
+    glm::mat4 tilt = glm::rotate(glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(1.0f, 0.0f, 0.0f)),
+                                 glm::radians(40.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::map<std::string, std::function<Frame()>> scenes;
+    scenes["triangle"] = [ ]() { return triangle(); };
+    scenes["model"]    = [ ]() { return model("Tests/sphere.obj", false, glm::mat4(1.0f)); };
+    scenes["textured"] = [=]() { return model("Tests/cube.obj", true, tilt); };
+    scenes["overdraw"] = [ ]() { return overdraw(); };
+    scenes["shadows"]  = [ ]() { return shadows(); };
+    return scenes;
+}
+
+// Peak Resident Memory of this Process; Each Scene Runs in its Own Process
+double resident()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), & counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, & usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024.0;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Copy the Framebuffer into an Image, Top Row First
+Image capture()
+{
+    Image image = { kSize, kSize, std::vector<unsigned char>(kSize * kSize * 4) };
+    std::vector<unsigned char> rows(image.rgba.size());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, kSize, kSize, GL_RGBA, GL_UNSIGNED_BYTE, rows.data());
+    for (int y = 0; y < kSize; y++)
+        std::copy(& rows[(kSize - 1 - y) * kSize * 4], & rows[(kSize - y) * kSize * 4], & image.rgba[y * kSize * 4]);
+    return image;
+}
+
+// Compare a Rendered Frame Against its Golden Image
+int regression(std::string const & name, Image const & actual, bool update)
+{
+    std::string golden = PROJECT_SOURCE_DIR "/Glitter/Tests/Golden/" + name + ".png";
+    if (update)
+    {   directory(PROJECT_SOURCE_DIR "/Glitter/Tests/Golden");
+        if (!save(golden, actual)) { fprintf(stderr, "%s %s\n", "Failed to Write", golden.c_str()); return EXIT_FAILURE; }
+        fprintf(stdout, "%s %s\n", "Updated", golden.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    // A Missing Golden is a Failure; Leave the Frame in the Working Directory for Review
+    Image expected;
+    if (!load(golden, expected))
+    {   save(name + ".actual.png", actual);
+        fprintf(stderr, "%s %s\n", "Missing Golden Image, Review and Rerun with --update to Accept", (name + ".actual.png").c_str());
+        return EXIT_FAILURE;
+    }
+
+    Difference difference = compare(expected, actual, kRadius, kDeltaE);
+    fprintf(stdout, "%s: mean %.3f, max %.3f, %.4f%% of pixels above %.1f\n",
+            name.c_str(), difference.mean, difference.max, difference.fraction * 100.0f, kDeltaE);
+    if (difference.fraction <= kFraction) return EXIT_SUCCESS;
+    save(name + ".actual.png", actual);
+    save(name + ".diff.png", difference.map);
+    fprintf(stderr, "%s %s\n", "Image Regression, See", (name + ".diff.png").c_str());
+    return EXIT_FAILURE;
+}
+
+// Time the Scene and Check it Against the Stored Baseline
+int performance(std::string const & name, Frame const & frame, bool record)
+{
+    for (int i = 0; i < kWarmUp; i++) frame();
+    glFinish();
+
+    // Wall Clock Includes Driver Overhead; the Timer Query Isolates the GPU
+    GLuint query; glGenQueries(1, & query);
+    auto start = std::chrono::steady_clock::now();
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < kFrames; i++) { frame(); glFinish(); }
+    glEndQuery(GL_TIME_ELAPSED);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, & nanoseconds);
+    glDeleteQueries(1, & query);
+
+    Metrics metrics;
+    metrics.cpu  = elapsed.count() / kFrames;
+    metrics.gpu  = nanoseconds / 1e6 / kFrames;
+    metrics.rss  = resident();
+    fprintf(stdout, "%s: cpu %.3f ms, gpu %.3f ms, rss %.0f KB\n",
+            name.c_str(), metrics.cpu, metrics.gpu, metrics.rss);
+    if (report) report();
+
+    // The Baseline Holds One Line per Scene: name cpu gpu rss. Absolute Timings Only Mean
+    // Something on the Machine That Recorded Them, so CTest Runs These Only When Asked,
+    // and Only --record Writes the File; a Normal Run Never Touches the Source Tree
+    std::string filename = PROJECT_SOURCE_DIR "/Glitter/Tests/baseline.txt";
+    std::map<std::string, Metrics> baseline;
+    std::ifstream in(filename);
+    for (std::string line; std::getline(in, line);)
+    {   std::istringstream fields(line); std::string scene; Metrics entry;
+        if (fields >> scene >> entry.cpu >> entry.gpu >> entry.rss) baseline[scene] = entry;
+    }
+    in.close();
+    if (record)
+    {   baseline[name] = metrics;
+        std::ofstream out(filename);
+        if (!out) { fprintf(stderr, "%s %s\n", "Failed to Write", filename.c_str()); return EXIT_FAILURE; }
+        for (auto & entry : baseline)
+            out << entry.first << " " << entry.second.cpu << " " << entry.second.gpu << " "
+                << entry.second.rss << "\n";
+        fprintf(stdout, "%s %s\n", "Recorded Baseline for", name.c_str());
+        return EXIT_SUCCESS;
+    }
+    if (baseline.find(name) == baseline.end())
+    {   fprintf(stderr, "%s %s%s\n", "Missing Baseline for", name.c_str(), ", Rerun with --perf --record to Accept");
+        return EXIT_FAILURE;
+    }
+
+    // Small Absolute Floors Keep Timer Noise on Trivial Scenes from Failing the Build
+    int failures = 0;
+    auto check = [&](char const * label, double value, double reference, double floor)
+    {   if (value <= reference * (1.0 + kRegression) || value - reference <= floor) return;
+        fprintf(stderr, "%s %s: %.3f, Baseline %.3f\n", "Performance Regression in", label, value, reference);
+        failures++;
+    };
+    Metrics & reference = baseline[name];
+    check("cpu",  metrics.cpu,  reference.cpu,  0.05);
+    check("gpu",  metrics.gpu,  reference.gpu,  0.05);
+    check("rss",  metrics.rss,  reference.rss,  1024.0);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char * argv[]) {
+
+    // RenderTests <scene> [--update] [--perf] [--record]
+    auto all = scenes();
+    std::string name = argc > 1 ? argv[1] : "";
+    bool update = false, perf = false, record = false;
+    for (int i = 2; i < argc; i++)
+    {        if (std::strcmp(argv[i], "--update") == 0) update = true;
+        else if (std::strcmp(argv[i], "--perf")   == 0) perf   = true;
+        else if (std::strcmp(argv[i], "--record") == 0) record = true;
+    }
+    if (all.find(name) == all.end())
+    {   fprintf(stderr, "%s\n", "Usage: RenderTests <scene> [--update] [--perf] [--record]");
+        for (auto & scene : all) fprintf(stderr, "    %s\n", scene.first.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // Machines Without a Display or GPU Skip Rather Than Fail
+    if (!glfwInit()) { fprintf(stderr, "%s\n", "Failed to Initialize GLFW"); return kSkip; }
+    // Scenes Drawn Through Mirage's Passes Use OpenGL 4.3 Shaders
+    bool modern = name == "overdraw" || name == "shadows";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, modern ? 4 : 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    auto window = glfwCreateWindow(kSize, kSize, "RenderTests", nullptr, nullptr);
+    if (window == nullptr)
+    {   fprintf(stderr, "%s\n", "Failed to Create OpenGL Context");
+        glfwTerminate();
+        return kSkip;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+
+    // Render Offscreen so the Result Does Not Depend on the Window System
+    GLuint framebuffer, renderbuffers[2];
+    glGenFramebuffers(1, & framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kSize, kSize);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, kSize, kSize);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  GL_RENDERBUFFER, renderbuffers[1]);
+    glViewport(0, 0, kSize, kSize);
+
+    // Scene Objects Must be Released Before the Context
+    int result;
+    {
+        Frame frame = all[name]();
+        frame();
+        result = perf ? performance(name, frame, record)
+                      : regression(name, capture(), update);
+        report = nullptr;
+    }
+
+    glDeleteFramebuffers(1, & framebuffer);
+    glDeleteRenderbuffers(2, renderbuffers);
+    glfwTerminate();
+    return result;
+}
@@ -0,0 +1,101 @@
+// Local Headers
+#include "check.hpp"
+#include "resources.hpp"
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// An Asset Record Last Used in a Given Frame, with CPU Geometry and GPU Bytes
+static Mirage::ResourceInfo record(char const * name, unsigned long used, std::size_t cpu, std::size_t gpu)
+{
+    Mirage::ResourceInfo info = Mirage::ResourceInfo();
+    info.name = name;
+    info.lastUsed = used;
+    info.resident = true;
+    info.usage[Mirage::ResourceGeometry].cpu = cpu;
+    info.usage[Mirage::ResourceGeometry].gpu = gpu;
+    return info;
+}
+
+// Runs the Policy Over Copies of the Records, Logging Each Action in Order
+struct Run {
+    std::vector<Mirage::ResourceInfo> infos;
+    std::vector<std::string> log;
+    Mirage::ResourceUsage total;
+    bool within;
+
+    Run(std::vector<Mirage::ResourceInfo> records, Mirage::ResourceBudget budget,
+        unsigned long frame, std::size_t kept = 0) : infos(records), total(), within(false)
+    {
+        std::vector<Mirage::ResourceInfo *> assets;
+        for (auto & info : infos)
+        {   assets.push_back(& info);
+            for (auto & usage : info.usage) { total.cpu += usage.cpu; total.gpu += usage.gpu; }
+        }
+
+        // Releasing Keeps kept Bytes, Like a Rigged Mesh that Still Needs its Vertices
+        auto release = [&](std::size_t i)
+        {   auto & cpu = infos[i].usage[Mirage::ResourceGeometry].cpu;
+            std::size_t freed = cpu - std::min(cpu, kept);
+            cpu -= freed;
+            log.push_back("release " + infos[i].name);
+            return freed;
+        };
+        auto evict = [&](std::size_t i)
+        {   for (auto & usage : infos[i].usage) usage = Mirage::ResourceUsage();
+            infos[i].resident = false;
+            log.push_back("evict " + infos[i].name);
+        };
+        within = Mirage::enforce(assets, budget, frame, total, release, evict);
+    }
+};
+
+int main() {
+
+    // Three Meshes Used in Frames 3, 1 and 2, Each with 100 Bytes of CPU Geometry
+    std::vector<Mirage::ResourceInfo> meshes = {
+        record("a", 3, 100, 10), record("b", 1, 100, 10), record("c", 2, 100, 10) };
+
+    // Within Budget Nothing Happens
+    Run idle(meshes, Mirage::ResourceBudget { 300, 30, 0 }, 4);
+    check(idle.within && idle.log.empty(), "within budget does nothing");
+
+    // Over the CPU Budget, CPU Copies Go First, Oldest First, and Only as Many as Needed
+    Run strip(meshes, Mirage::ResourceBudget { 150, 0, 0 }, 4);
+    check(strip.within && strip.log.size() == 2, "release stops once under budget");
+    check(strip.log.size() == 2 && strip.log[0] == "release b" && strip.log[1] == "release c",
+          "release least recently used first");
+    check(strip.total.cpu == 100, "released bytes leave the total");
+
+    // When Releasing Cannot Free Enough, Whole Assets are Evicted Oldest First
+    Run rigged(meshes, Mirage::ResourceBudget { 150, 0, 0 }, 4, 100);
+    check(rigged.within && rigged.log.size() == 5, "evict after releasing fails");
+    check(rigged.log.size() == 5 && rigged.log[3] == "evict b" && rigged.log[4] == "evict c",
+          "evict least recently used first");
+    check(rigged.infos[0].resident && !rigged.infos[1].resident, "newest asset survives");
+
+    // The GPU Budget Alone Skips Straight to Eviction
+    Run video(meshes, Mirage::ResourceBudget { 0, 25, 0 }, 4);
+    check(video.log.size() == 1 && video.log[0] == "evict b" && video.total.gpu == 20,
+          "gpu budget evicts without releasing");
+
+    // Assets Used This Frame are Never Touched, Even Over Budget
+    Run busy(meshes, Mirage::ResourceBudget { 0, 5, 0 }, 3);
+    check(!busy.within, "over budget reported when only assets in use remain");
+    check(busy.infos[0].resident && busy.log.size() == 2, "assets in use are kept");
+
+    // A Missing Texture is Remembered as Failed Rather Than Counted as a Load
+    Mirage::Resources resources(Mirage::ResourceBudget { 0, 0, 0 });
+    check(resources.texture("missing/texture.png") == 0, "missing texture returns zero");
+    resources.frame();
+    check(resources.texture("missing/texture.png") == 0, "missing texture stays missing");
+    auto assets = resources.assets();
+    check(assets.size() == 1 && assets[0].failed && !assets[0].resident && assets[0].loads == 0,
+          "failed load recorded without a load");
+    check(resources.last().touched == 1 && resources.last().loaded.gpu == 0, "failure loads nothing");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,61 @@
+// Local Headers
+#include "check.hpp"
+#include "scene.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+
+// Translation Stored in a World Matrix
+static glm::vec3 offset(Mirage::Scene const & scene, int node)
+{
+    return glm::vec3(scene.world(node)[3]);
+}
+
+static glm::mat4 move(float x, float y, float z)
+{
+    return glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+}
+
+int main() {
+
+    // root -> arm -> hand -> finger, and root -> leg; Adding Nodes Marks Them All
+    Mirage::Scene scene;
+    int root   = scene.add("root",   -1,   move(1.0f, 0.0f, 0.0f));
+    int arm    = scene.add("arm",    root, move(0.0f, 1.0f, 0.0f));
+    int hand   = scene.add("hand",   arm,  move(0.0f, 0.0f, 1.0f));
+    int finger = scene.add("finger", hand, move(0.0f, 0.0f, 1.0f));
+    int leg    = scene.add("leg",    root, move(0.0f, -1.0f, 0.0f));
+    check(scene.update() == 5, "new nodes all computed");
+    check(scene.update() == 0, "clean scene costs nothing");
+    check(offset(scene, finger) == glm::vec3(1.0f, 1.0f, 2.0f), "world composes down the chain");
+    check(scene.find("hand") == hand && scene.find("tail") == -1, "nodes found by name");
+
+    // Changing a Leaf Only Recomputes the Leaf
+    scene.set(leg, move(0.0f, -2.0f, 0.0f));
+    check(scene.update() == 1, "leaf change recomputes one node");
+    check(offset(scene, leg) == glm::vec3(1.0f, -2.0f, 0.0f), "leaf moved");
+
+    // Nested Changed Roots, Set Child First, Gather Their Shared Subtree Once
+    scene.set(hand, move(0.0f, 0.0f, 2.0f));
+    scene.set(arm,  move(0.0f, 3.0f, 0.0f));
+    scene.set(hand, move(0.0f, 0.0f, 4.0f));
+    check(scene.update() == 3, "nested roots count each node once");
+    check(offset(scene, hand)   == glm::vec3(1.0f, 3.0f, 4.0f), "latest local wins");
+    check(offset(scene, finger) == glm::vec3(1.0f, 3.0f, 5.0f), "descendant of nested roots updated");
+    check(offset(scene, leg)    == glm::vec3(1.0f, -2.0f, 0.0f), "sibling subtree untouched");
+
+    // Moving the Root Moves Everything
+    scene.set(root, move(0.0f, 0.0f, 0.0f));
+    check(scene.update() == 5, "root change recomputes the whole tree");
+    check(offset(scene, finger) == glm::vec3(0.0f, 3.0f, 5.0f), "root offset removed");
+
+    // A Parent that Does Not Precede its Child Becomes a Root
+    int orphan = scene.add("orphan", 42, move(5.0f, 0.0f, 0.0f));
+    check(scene.parent(orphan) == -1 && scene.update() == 1, "late parent rejected");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+// Local Headers
+#include "check.hpp"
+#include "shadows.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+
+// Tiles Must Sit on Their Own Grid, Inside the Atlas, Without Overlapping
+static bool packed(Mirage::Shadows const & shadows, int views, int size)
+{
+    for (int i = 0; i < views; i++)
+    {
+        glm::ivec4 a = shadows.tile(i);
+        if (a.z == 0 || a.x % a.z || a.y % a.z || a.x + a.z > size || a.y + a.z > size) return false;
+        for (int j = 0; j < i; j++)
+        {   glm::ivec4 b = shadows.tile(j);
+            if (a.x < b.x + b.z && b.x < a.x + a.z && a.y < b.y + b.z && b.y < a.y + a.z) return false;
+        }
+    }   return true;
+}
+
+int main() {
+
+    // Two Cascades and a Point Light; Declaring Views Never Touches the GPU
+    Mirage::Shadows shadows(1024);
+    glm::vec3 sun = glm::normalize(glm::vec3(0.3f, -1.0f, 0.2f));
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    auto frame = [&](int cascades, glm::vec3 const & lamp, int faces)
+    {   shadows.begin();
+        for (int i = 0; i < cascades; i++)
+            shadows.cascade(sun, view, glm::radians(60.0f), 1.0f, 0.1f, 100.0f, i, 2, 512);
+        for (int face = 0; face < faces; face++)
+            shadows.point(lamp, 10.0f, face, 100);
+        shadows.end();
+    };
+
+    // Requests are Rounded Up to a Tile, and Tiles Pack Without Overlap
+    frame(2, glm::vec3(1.0f, 2.0f, 0.0f), 6);
+    check(shadows.tile(0).z == 512 && shadows.tile(1).z == 512, "cascades get their requested size");
+    check(shadows.tile(2).z == 128, "small requests round up to the minimum tile");
+    check(packed(shadows, 8, 1024), "tiles are aligned and disjoint");
+    check(shadows.stats().utilization == 0.5f + 6.0f / 64.0f, "utilization counts allocated area");
+    check(shadows.stats().cached == 0, "new views draw their static casters");
+
+    // An Unchanged Frame Reuses Every Cached View, Even if end() is Called Twice
+    frame(2, glm::vec3(1.0f, 2.0f, 0.0f), 6);
+    shadows.end();
+    check(shadows.stats().cached == 8, "unchanged views skip static casters");
+
+    // Moving the Lamp Only Invalidates its Own Faces
+    frame(2, glm::vec3(1.5f, 2.0f, 0.0f), 6);
+    check(shadows.stats().cached == 2, "moved views redraw static casters");
+    shadows.invalidate();
+    frame(2, glm::vec3(1.5f, 2.0f, 0.0f), 6);
+    check(shadows.stats().cached == 0, "invalidate forces a redraw");
+
+    // Views Not Declared Give Their Tiles Back, and Freed Buddies Merge
+    frame(2, glm::vec3(1.5f, 2.0f, 0.0f), 0);
+    check(shadows.stats().utilization == 0.5f, "dropped views release their tiles");
+    frame(0, glm::vec3(0.0f), 0);
+    check(shadows.stats().utilization == 0.0f, "an empty frame frees the atlas");
+    shadows.begin();
+    shadows.cascade(sun, view, glm::radians(60.0f), 1.0f, 0.1f, 100.0f, 0, 1, 1024);
+    shadows.end();
+    glm::ivec4 whole = shadows.tile(0);
+    check(whole.x == 0 && whole.y == 0 && whole.z == 1024, "released tiles coalesce into the whole atlas");
+    check(shadows.stats().utilization == 1.0f, "a full-size view fills the atlas");
+
+    // A View That Does Not Fit is Dropped Rather Than Overlapping Another
+    shadows.begin();
+    shadows.cascade(sun, view, glm::radians(60.0f), 1.0f, 0.1f, 100.0f, 0, 1, 1024);
+    shadows.point(glm::vec3(0.0f), 10.0f, 0, 128);
+    shadows.end();
+    check(shadows.tile(1).z == 0, "a full atlas drops the extra view");
+
+    // Invalid Atlas Sizes Round Down, and Requests are Clamped to the Atlas
+    Mirage::Shadows small(1000);
+    small.begin();
+    small.point(glm::vec3(0.0f), 10.0f, 0, 4096);
+    small.end();
+    check(small.tile(0).z == 512, "atlas rounds down to a power of two");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,65 @@
+// Local Headers
+#include "check.hpp"
+#include "animation.hpp"
+
+// Standard Headers
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Weight of a Joint in an Influence, Zero When the Joint is Absent
+static float weight(Mirage::Influence const & influence, GLushort joint)
+{
+    float total = 0.0f;
+    for (int k = 0; k < 4; k++)
+        if (influence.weights[k] > 0.0f && influence.bones[k] == joint) total += influence.weights[k];
+    return total;
+}
+
+// Number of Slots Holding a Joint
+static int slots(Mirage::Influence const & influence, GLushort joint)
+{
+    int count = 0;
+    for (int k = 0; k < 4; k++)
+        count += influence.weights[k] > 0.0f && influence.bones[k] == joint;
+    return count;
+}
+
+static bool near(float a, float b) { return std::fabs(a - b) < 1e-5f; }
+
+int main() {
+
+    // Imported Vertices 0 and 1 are the Same Corner, Welded into Vertex 0; Both Carry
+    // Joints 1, 2 and 3. Vertex 2 Has Five Joints and Becomes Welded Vertex 1
+    std::vector<GLuint> remap = { 0, 0, 1 };
+    std::vector<Mirage::BoneWeight> weights = {
+        { 0, 1, 0.5f }, { 0, 2, 0.3f }, { 0, 3, 0.2f },
+        { 1, 1, 0.5f }, { 1, 2, 0.3f }, { 1, 3, 0.2f },
+        { 2, 1, 0.1f }, { 2, 2, 0.4f }, { 2, 3, 0.2f }, { 2, 4, 0.2f }, { 2, 5, 0.1f },
+        { 7, 1, 1.0f }
+    };
+    std::vector<Mirage::Influence> influences;
+    Mirage::weigh(weights, remap, 2, influences);
+    check(influences.size() == 2, "one influence per welded vertex");
+
+    // The Duplicate Corner Must Not Push Out the Weakest Joint
+    auto & corner = influences[0];
+    check(slots(corner, 1) == 1 && slots(corner, 2) == 1 && slots(corner, 3) == 1, "welded joints counted once");
+    check(near(weight(corner, 1), 0.5f) && near(weight(corner, 2), 0.3f) && near(weight(corner, 3), 0.2f),
+          "welded weights unchanged");
+
+    // Only the Four Strongest Survive, Renormalized
+    auto & crowded = influences[1];
+    float total = crowded.weights.x + crowded.weights.y + crowded.weights.z + crowded.weights.w;
+    check(near(total, 1.0f), "weights normalized");
+    check(near(weight(crowded, 2), 0.4f / 0.9f) && weight(crowded, 3) > 0.0f && weight(crowded, 4) > 0.0f,
+          "strongest four kept");
+    check(slots(crowded, 1) + slots(crowded, 5) == 1, "one of the weakest dropped");
+
+    // Weights on Vertices Outside the Remap are Ignored
+    Mirage::weigh(weights, std::vector<GLuint>(), 2, influences);
+    check(influences.size() == 2 && influences[0].weights.x == 0.0f && influences[1].weights.x == 0.0f,
+          "unknown vertices ignored");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
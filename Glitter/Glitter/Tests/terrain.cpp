@@ -0,0 +1,110 @@
+// Local Headers
+#include "check.hpp"
+#include "terrain.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Define Some Constants
+const float kTolerance = 0.01f;   // One Height Step; Quantizing Costs at Most Half of One
+
+// A Plane Interpolates Exactly, so Only Quantization Separates Baked Heights from It
+static float slope(float x, float z)
+{
+    return 0.5f * x + 0.25f * z - 3.0f;
+}
+
+static bool near(float a, float b)
+{
+    return std::fabs(a - b) <= kTolerance;
+}
+
+int main(int argc, char * argv[]) {
+
+    // TerrainTests <scratch file>; an Absolute Path Keeps the File Out of Mirage/Terrain
+    if (argc < 2) { fprintf(stderr, "%s\n", "Usage: TerrainTests <absolute scratch path>"); return EXIT_FAILURE; }
+    std::string path = argv[1];
+
+    // Three Levels of 8 by 8 Quad Tiles: 1, 4 and 16 Tiles, 32 Units Across at the Finest
+    Mirage::TerrainHeader layout = { {}, 0, 8, 3, 1.0f, -10.0f, 0.01f, 0 };
+    check(Mirage::Terrain::first(0) == 0 && Mirage::Terrain::first(1) == 1
+       && Mirage::Terrain::first(2) == 5 && Mirage::Terrain::first(3) == 21, "tiles are counted coarsest first");
+    Mirage::TerrainHeader odd = layout; odd.tileSize = 7;
+    check(!Mirage::Terrain::bake(path, odd, slope), "odd tile sizes are rejected");
+    check( Mirage::Terrain::bake(path, layout, slope), "bake writes the file");
+
+    // The File Holds the Header, the Bounds Table, Then Every Tile
+    std::ifstream fd(path, std::ios::binary);
+    std::vector<char> file((std::istreambuf_iterator<char>(fd)), std::istreambuf_iterator<char>());
+    std::size_t samples = 9 * 9, tiles = Mirage::Terrain::first(3);
+    check(file.size() == sizeof(Mirage::TerrainHeader) + tiles * (sizeof(Mirage::TerrainBounds) + samples * 2), "file size matches the layout");
+
+    // Tile (3, 1) of Level 2 Sits at first(2) + 1 * 4 + 3, Sampled at the Finest Spacing
+    if (file.size() >= sizeof(Mirage::TerrainHeader) + tiles * (sizeof(Mirage::TerrainBounds) + samples * 2))
+    {
+        std::size_t index = Mirage::Terrain::first(2) + (1 << 2) + 3;
+        auto bounds = reinterpret_cast<Mirage::TerrainBounds const *>(& file[sizeof(Mirage::TerrainHeader)]);
+        auto values = reinterpret_cast<std::uint16_t const *>(bounds + tiles) + index * samples;
+        bool placed = true;
+        std::uint16_t low = 0xFFFF, high = 0;
+        for (int j = 0; j < 9; j++)
+        for (int i = 0; i < 9; i++)
+        {   std::uint16_t value = values[j * 9 + i];
+            placed = placed && near(layout.low + layout.scale * value, slope(24.0f + i, 8.0f + j));
+            low = std::min(low, value); high = std::max(high, value);
+        }
+        check(placed, "tiles are stored at their first() index");
+        check(bounds[index].low == low && bounds[index].high == high, "bounds table matches the tile");
+    }
+
+    // Mapping it Back Needs No GPU; Heights Round Trip Through Quantization
+    {
+        Mirage::Terrain terrain(path, 4, 2);
+        check(terrain.size() == 32.0f, "world size follows the layout");
+        check(near(terrain.height( 0.0f,  0.0f), slope( 0.0f,  0.0f))
+           && near(terrain.height(10.3f, 20.7f), slope(10.3f, 20.7f))
+           && near(terrain.height(31.9f,  5.5f), slope(31.9f,  5.5f)), "height round trips through the file");
+        check(near(terrain.height(40.0f, -5.0f), slope(32.0f, 0.0f)), "height clamps to the world edge");
+
+        // Level 1, Tile (1, 0): Two Units per Quad, Starting at x = 16
+        std::vector<Mirage::TerrainVertex> vertices;
+        terrain.chunk(1, 1, 0, vertices);
+        check(vertices.size() == 9 * 9 + 4 * 9, "a chunk holds its grid and four skirts");
+        if (vertices.size() == 9 * 9 + 4 * 9)
+        {
+            bool grid = true, heights = true, coarse = true, skirts = true;
+            for (int j = 0; j < 9; j++)
+            for (int i = 0; i < 9; i++)
+            {   auto & vertex = vertices[j * 9 + i];
+                grid    = grid    && vertex.grid.x == i && vertex.grid.y == j;
+                heights = heights && near(vertex.height, slope(16.0f + 2.0f * i, 2.0f * j));
+                coarse  = coarse  && vertex.coarse == vertices[(j & ~1) * 9 + (i & ~1)].height;
+            }
+            for (int k = 0; k < 9; k++)
+            {   skirts = skirts && vertices[81 + 0 * 9 + k].height == vertices[k].height - 8.0f;
+                skirts = skirts && vertices[81 + 1 * 9 + k].height == vertices[k * 9 + 8].height - 8.0f;
+                skirts = skirts && vertices[81 + 1 * 9 + k].coarse == vertices[k * 9 + 8].coarse - 8.0f;
+            }
+            check(grid,    "chunk vertices are laid out row by row");
+            check(heights, "chunk heights are sampled at the level's spacing");
+            check(coarse,  "odd vertices morph to the even grid point");
+            check(skirts,  "skirts hang four spacings below the edge");
+        }
+
+        // The Root Has No Parent to Morph To
+        terrain.chunk(0, 0, 0, vertices);
+        bool still = !vertices.empty();
+        for (std::size_t i = 0; i < 81 && still; i++) still = vertices[i].coarse == vertices[i].height;
+        check(still, "root vertices do not morph");
+    }
+
+    std::remove(path.c_str());
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,458 @@
+// Preprocessor Directives
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+// Local Headers
+#include "mesh.hpp"
+#include "shader.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+// Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Define Some Constants
+const int   kAtlas   = 2048;   // Edge of Each Offscreen Atlas in Pixels
+const int   kAhead   = 2;      // Models Decoded Ahead of the One Being Rendered
+const int   kBacklog = 256;    // Images Waiting for an Encoder Before Rendering Blocks
+const float kFov     = 35.0f;  // Default Vertical Field of View in Degrees
+
+// A Camera Orbiting the Model's Bounding Sphere, Angles in Degrees
+struct View {
+    std::string name;
+    float azimuth;
+    float elevation;
+    float fov;
+};
+
+// One Sub-Mesh Decoded Off the Render Thread; texture Indexes Job::pictures or is -1
+struct Part {
+    std::vector<Mirage::Vertex> vertices;
+    std::vector<GLuint> indices;
+    int texture;
+};
+
+// Texels Owned by stb_image Until They are Uploaded
+struct Picture {
+    unsigned char * texels;
+    int width;
+    int height;
+    int channels;
+};
+
+// Everything the Render Thread Needs for One Model
+struct Job {
+    std::string model;
+    std::vector<Part> parts;
+    std::vector<Picture> pictures;
+    glm::vec3 center;
+    float radius;
+};
+
+// One Finished View Waiting for an Encoder, Top Row First
+struct Output {
+    std::string filename;
+    int size;
+    std::vector<unsigned char> rgba;
+};
+
+// An Offscreen Target Drawn Into While the Other is Read Back
+struct Atlas {
+    GLuint framebuffer;
+    GLuint renderbuffers[2];
+    GLuint pack;
+    GLsync fence;
+    std::vector<std::string> names;   // Output File for Each Filled Cell
+};
+
+// Bounded Queue Between Threads; pop Returns False Once Closed and Drained
+template<typename T> class Channel
+{
+public:
+
+    explicit Channel(std::size_t capacity) : mCapacity(capacity), mClosed(false) {}
+
+    void push(T item)
+    {   std::unique_lock<std::mutex> lock(mMutex);
+        mSpace.wait(lock, [this] { return mItems.size() < mCapacity; });
+        mItems.push_back(std::move(item));
+        mReady.notify_one();
+    }
+
+    bool pop(T & item)
+    {   std::unique_lock<std::mutex> lock(mMutex);
+        mReady.wait(lock, [this] { return mClosed || !mItems.empty(); });
+        if (mItems.empty()) return false;
+        item = std::move(mItems.front());
+        mItems.pop_front();
+        mSpace.notify_one();
+        return true;
+    }
+
+    void close()
+    {   std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        mReady.notify_all();
+    }
+
+private:
+
+    std::size_t mCapacity;
+    std::deque<T> mItems;
+    std::mutex mMutex;
+    std::condition_variable mReady;
+    std::condition_variable mSpace;
+    bool mClosed;
+};
+
+// Seconds Since a Point in Time
+double since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Read "model <path>" and "view <name> <azimuth> <elevation> [fov]" Lines; Every View
+// is Rendered for Every Model, and Models are Relative to Mirage/Models Like Mesh
+bool manifest(std::string const & filename, std::vector<std::string> & models, std::vector<View> & views)
+{
+    std::ifstream fd(filename);
+    if (!fd) { fprintf(stderr, "%s %s\n", "Failed to Open Manifest", filename.c_str()); return false; }
+    int number = 0;
+    for (std::string line; std::getline(fd, line);)
+    {
+        number++;
+        std::istringstream fields(line);
+        std::string kind, model;
+        View view = { "", 0.0f, 0.0f, kFov };
+        if (!(fields >> kind) || kind[0] == '#') continue;
+        if (kind == "model" && fields >> model) { models.push_back(model); continue; }
+        if (kind == "view" && fields >> view.name >> view.azimuth >> view.elevation)
+        {   float fov;
+            if (fields >> fov) view.fov = fov;
+            views.push_back(view);
+            continue;
+        }
+        fprintf(stderr, "%s %s:%d\n", "Malformed Manifest Line", filename.c_str(), number);
+        return false;
+    }
+    if (views.empty()) views.push_back(View { "front", 30.0f, 20.0f, kFov });
+    return true;
+}
+
+// Import, Flatten and Decode a Model Without Touching OpenGL. Node Transforms are Baked
+// into the Vertices, so Parts are Drawn and Framed in Model Space
+Job load(std::string const & model)
+{
+    Job job;
+    job.model  = model;
+    job.center = glm::vec3(0.0f);
+    job.radius = 1.0f;
+    Assimp::Importer loader;
+    aiScene const * scene = loader.ReadFile(
+        PROJECT_SOURCE_DIR "/Mirage/Models/" + model,
+        Mirage::kImport | aiProcess_PreTransformVertices);
+    if (!scene) { fprintf(stderr, "%s\n", loader.GetErrorString()); return job; }
+
+    // Decode Each Diffuse Texture Once per Model
+    auto index = model.find_last_of("/");
+    auto path  = index == std::string::npos ? std::string() : model.substr(0, index + 1);
+    std::map<std::string, int> cache;
+    glm::vec3 low(std::numeric_limits<float>::max()), high(-std::numeric_limits<float>::max());
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+    {
+        aiMesh const * mesh = scene->mMeshes[i];
+        Part part;
+        part.texture = -1;
+        Mirage::Mesh::extract(mesh, part.vertices, part.indices);
+        if (part.indices.empty()) continue;
+        for (auto & vertex : part.vertices)
+        {   low  = glm::min(low,  vertex.position);
+            high = glm::max(high, vertex.position);
+        }
+
+        aiMaterial * material = scene->mMaterials[mesh->mMaterialIndex];
+        if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+        {
+            aiString str; material->GetTexture(aiTextureType_DIFFUSE, 0, & str);
+            std::string name = path + str.C_Str();
+            if (cache.find(name) == cache.end())
+            {
+                Picture picture = {};
+                std::string filename = PROJECT_SOURCE_DIR "/Mirage/Models/" + name;
+                picture.texels = stbi_load(filename.c_str(), & picture.width, & picture.height, & picture.channels, 0);
+                if (!picture.texels) fprintf(stderr, "%s %s\n", "Failed to Load Texture", filename.c_str());
+                cache[name] = picture.texels ? static_cast<int>(job.pictures.size()) : -1;
+                if (picture.texels) job.pictures.push_back(picture);
+            }
+            part.texture = cache[name];
+        }
+        job.parts.push_back(std::move(part));
+    }
+
+    // Frame the Bounding Sphere
+    if (job.parts.empty()) return job;
+    job.center = (low + high) * 0.5f;
+    job.radius = std::max(glm::length(high - low) * 0.5f, 1e-4f);
+    return job;
+}
+
+// Flatten a Model Path into a File Name: "a/b.obj" Becomes "a_b"
+std::string stem(std::string const & model)
+{
+    std::string name = model.substr(0, model.rfind("."));
+    std::replace(name.begin(), name.end(), '/', '_');
+    std::replace(name.begin(), name.end(), '\\', '_');
+    return name;
+}
+
+int main(int argc, char * argv[]) {
+
+    // Farm manifest.txt output/ [--size pixels] [--encoders threads]
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s manifest.txt existing/output/directory [--size 256] [--encoders 1]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int size = 256, encoders = 1;
+    for (int i = 3; i + 1 < argc; i += 2)
+    {        if (std::strcmp(argv[i], "--size")     == 0) size     = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--encoders") == 0) encoders = std::atoi(argv[i + 1]);
+    }
+    size = std::min(std::max(size, 16), kAtlas);
+    encoders = std::max(encoders, 1);
+    std::vector<std::string> models;
+    std::vector<View> views;
+    if (!manifest(argv[1], models, views)) return EXIT_FAILURE;
+    std::string directory = argv[2];
+
+    // A Hidden Window is Enough for Offscreen Rendering, Including on Software Drivers
+    if (!glfwInit()) { fprintf(stderr, "%s\n", "Failed to Initialize GLFW"); return EXIT_FAILURE; }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    auto window = glfwCreateWindow(16, 16, "Farm", nullptr, nullptr);
+    if (window == nullptr)
+    {   fprintf(stderr, "%s\n", "Failed to Create OpenGL Context");
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+
+    // Start Timing Before the Workers so Loading the First Model Counts
+    auto start = std::chrono::steady_clock::now();
+    Channel<Job> loaded(kAhead);
+    Channel<Output> encoded(kBacklog);
+
+    // Decode the Next Models While the Current One Renders
+    double loading = 0.0;
+    std::thread loader([&]()
+    {   for (auto & model : models)
+        {   auto begin = std::chrono::steady_clock::now();
+            Job job = load(model);
+            loading += since(begin);
+            loaded.push(std::move(job));
+        }   loaded.close();
+    });
+
+    // Compress PNGs Off the Render Thread
+    std::vector<double> encoding(encoders, 0.0);
+    std::vector<int> failures(encoders, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < encoders; i++)
+        threads.push_back(std::thread([&, i]()
+        {   Output output;
+            while (encoded.pop(output))
+            {   auto begin = std::chrono::steady_clock::now();
+                if (!stbi_write_png(output.filename.c_str(), output.size, output.size, 4,
+                                    output.rgba.data(), output.size * 4))
+                {   fprintf(stderr, "%s %s\n", "Failed to Write", output.filename.c_str());
+                    failures[i]++;
+                }
+                encoding[i] += since(begin);
+            }
+        }));
+
+    // Scope GL Objects so They are Released Before the Context
+    std::size_t images = 0;
+    int skipped = 0;
+    double waiting = 0.0, rendering = 0.0;
+    {
+        Mirage::Shader shader;
+        shader.attach("thumbnail.vert").attach("thumbnail.frag").link();
+        GLint textured = glGetUniformLocation(shader.get(), "textured");
+
+        // Each View Gets a Cell; Two Atlases Let Readback Overlap Drawing
+        int columns = std::max(kAtlas / size, 1), edge = columns * size;
+        std::size_t cells = static_cast<std::size_t>(columns) * columns;
+        Atlas atlases[2];
+        for (auto & atlas : atlases)
+        {   glGenFramebuffers(1, & atlas.framebuffer);
+            glGenRenderbuffers(2, atlas.renderbuffers);
+            glBindRenderbuffer(GL_RENDERBUFFER, atlas.renderbuffers[0]);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, edge, edge);
+            glBindRenderbuffer(GL_RENDERBUFFER, atlas.renderbuffers[1]);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, edge, edge);
+            glBindFramebuffer(GL_FRAMEBUFFER, atlas.framebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, atlas.renderbuffers[0]);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  GL_RENDERBUFFER, atlas.renderbuffers[1]);
+            glGenBuffers(1, & atlas.pack);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas.pack);
+            glBufferData(GL_PIXEL_PACK_BUFFER, std::size_t(edge) * edge * 4, nullptr, GL_STREAM_READ);
+            atlas.fence = nullptr;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // Copy a Whole Atlas into a Pixel Buffer Without Waiting for It
+        auto readback = [&](Atlas & atlas)
+        {   glBindFramebuffer(GL_READ_FRAMEBUFFER, atlas.framebuffer);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas.pack);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, edge, edge, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            atlas.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        };
+
+        // Once the Copy Lands, Cut the Atlas into Images for the Encoders
+        auto flush = [&](Atlas & atlas)
+        {   if (!atlas.fence) return;
+            auto begin = std::chrono::steady_clock::now();
+            glClientWaitSync(atlas.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(atlas.fence);
+            atlas.fence = nullptr;
+            waiting += since(begin);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas.pack);
+            auto pixels = static_cast<unsigned char const *>(
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, std::size_t(edge) * edge * 4, GL_MAP_READ_BIT));
+            for (std::size_t cell = 0; pixels && cell < atlas.names.size(); cell++)
+            {
+                int x = static_cast<int>(cell % columns) * size, y = static_cast<int>(cell / columns) * size;
+                Output output = { atlas.names[cell], size, std::vector<unsigned char>(std::size_t(size) * size * 4) };
+                for (int row = 0; row < size; row++)
+                    std::memcpy(& output.rgba[std::size_t(row) * size * 4],
+                                pixels + (std::size_t(y + size - 1 - row) * edge + x) * 4, size * 4);
+                encoded.push(std::move(output));
+                images++;
+            }
+            if (pixels) glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            atlas.names.clear();
+        };
+
+        int current = 0;
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_SCISSOR_TEST);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        for (;;)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            Job job;
+            if (!loaded.pop(job)) break;
+            waiting += since(begin);
+            if (job.parts.empty())
+            {   fprintf(stderr, "%s %s\n", "Skipped Model Without Geometry", job.model.c_str());
+                skipped++;
+                continue;
+            }
+            begin = std::chrono::steady_clock::now();
+
+            // Upload the Decoded Model; Texels are Freed as Soon as They Reach the Driver
+            std::vector<GLuint> textures;
+            for (auto & picture : job.pictures)
+            {   textures.push_back(Mirage::Mesh::upload(picture.texels, picture.width, picture.height, picture.channels));
+                stbi_image_free(picture.texels);
+            }
+            std::vector<std::unique_ptr<Mirage::Mesh>> meshes;
+            std::vector<int> flags;
+            for (auto & part : job.parts)
+            {   std::map<GLuint, std::string> bound;
+                if (part.texture >= 0) bound.insert(std::make_pair(textures[part.texture], "diffuse"));
+                meshes.push_back(std::unique_ptr<Mirage::Mesh>(new Mirage::Mesh(part.vertices, part.indices, bound)));
+                flags.push_back(part.texture >= 0);
+            }
+
+            for (auto & view : views)
+            {
+                // Full Atlas: Start its Readback, Then Reuse the Other One
+                if (atlases[current].names.size() == cells)
+                {   readback(atlases[current]);
+                    current ^= 1;
+                    flush(atlases[current]);
+                }
+
+                Atlas & atlas = atlases[current];
+                int cell = static_cast<int>(atlas.names.size());
+                int x = cell % columns * size, y = cell / columns * size;
+                glBindFramebuffer(GL_FRAMEBUFFER, atlas.framebuffer);
+                glViewport(x, y, size, size);
+                glScissor(x, y, size, size);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                // Back Off Until the Bounding Sphere Fills the Vertical Field of View
+                float azimuth = glm::radians(view.azimuth), elevation = glm::radians(view.elevation);
+                float fov = glm::radians(view.fov), distance = job.radius / std::sin(fov * 0.5f);
+                glm::vec3 direction(std::cos(elevation) * std::sin(azimuth), std::sin(elevation),
+                                    std::cos(elevation) * std::cos(azimuth));
+                glm::mat4 look = glm::lookAt(job.center + direction * distance, job.center, glm::vec3(0.0f, 1.0f, 0.0f));
+                glm::mat4 projection = glm::perspective(fov, 1.0f, std::max(distance - job.radius, distance * 0.01f),
+                                                        distance + job.radius);
+                shader.activate();
+                shader.bind("view", look).bind("projection", projection);
+                for (std::size_t i = 0; i < meshes.size(); i++)
+                {   glUniform1i(textured, flags[i]);
+                    meshes[i]->draw(shader.get());
+                }
+                atlas.names.push_back(directory + "/" + stem(job.model) + "_" + view.name + ".png");
+            }
+            glDeleteTextures(static_cast<GLsizei>(textures.size()), textures.data());
+            rendering += since(begin);
+        }
+
+        // Drain the Older Atlas First
+        if (!atlases[current].names.empty()) readback(atlases[current]);
+        flush(atlases[current ^ 1]);
+        flush(atlases[current]);
+        for (auto & atlas : atlases)
+        {   glDeleteFramebuffers(1, & atlas.framebuffer);
+            glDeleteRenderbuffers(2, atlas.renderbuffers);
+            glDeleteBuffers(1, & atlas.pack);
+        }
+    }
+
+    encoded.close();
+    loader.join();
+    for (auto & thread : threads) thread.join();
+    glfwTerminate();
+
+    // Throughput per Core is What Sizes a Farm
+    double seconds = since(start), encode = 0.0;
+    int failed = skipped;
+    for (int i = 0; i < encoders; i++) { encode += encoding[i]; failed += failures[i]; }
+    unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+    fprintf(stdout, "%zu images of %zu models in %.2f s: %.2f images/s, %.3f images/s/core on %u cores\n",
+            images, models.size(), seconds, images / seconds, images / seconds / cores, cores);
+    fprintf(stdout, "    load %.2f s, render %.2f s, render thread waiting %.2f s, encode %.2f s on %d threads\n",
+            loading, rendering, waiting, encode, encoders);
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+// Local Headers
+#include "bundle.hpp"
+#include "mesh.hpp"
+
+// System Headers
+#include <stb_image.h>
+
+// Standard Headers
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+// Append Raw Bytes to a Blob
+template<typename T> void append(std::vector<char> & blob, T const * data, std::size_t count)
+{
+    auto bytes = reinterpret_cast<char const *>(data);
+    blob.insert(blob.end(), bytes, bytes + count * sizeof(T));
+}
+
+// Decode a Texture Once and Store its Texels
+bool packTexture(Mirage::BundleWriter & writer, std::string const & name)
+{
+    int width, height, channels;
+    std::string filename = PROJECT_SOURCE_DIR "/Mirage/Models/" + name;
+    unsigned char * image = stbi_load(filename.c_str(), & width, & height, & channels, 0);
+    if (!image) { fprintf(stderr, "%s %s\n", "Failed to Load Texture", filename.c_str()); return false; }
+
+    Mirage::BundleImage header = {};
+    header.width    = width;
+    header.height   = height;
+    header.channels = channels;
+    std::vector<char> blob;
+    append(blob, & header, 1);
+    append(blob, image, width * height * channels);
+    stbi_image_free(image);
+    writer.add(name, Mirage::BundleTexture, 1, std::move(blob));
+    return true;
+}
+
+// Flatten a Model into Sub-Mesh Records, Packing Referenced Textures Along the Way
+bool packModel(Mirage::BundleWriter & writer, std::string const & name,
+               std::map<std::string, bool> & packed)
+{
+    Assimp::Importer loader;
+    aiScene const * scene = loader.ReadFile(
+        PROJECT_SOURCE_DIR "/Mirage/Models/" + name,
+        Mirage::kImport | aiProcess_OptimizeGraph);
+    if (!scene) { fprintf(stderr, "%s\n", loader.GetErrorString()); return false; }
+
+    // Visit Nodes in the Same Order as Mesh::parse
+    std::vector<aiNode const *> stack = { scene->mRootNode };
+    std::vector<aiMesh const *> meshes;
+    while (!stack.empty())
+    {
+        auto node = stack.back(); stack.pop_back();
+        for (unsigned int i = 0; i < node->mNumMeshes; i++)
+            meshes.push_back(scene->mMeshes[node->mMeshes[i]]);
+        for (unsigned int i = node->mNumChildren; i > 0; i--)
+            stack.push_back(node->mChildren[i - 1]);
+    }
+
+    std::vector<char> blob;
+    auto path = name.substr(0, name.find_last_of("/"));
+    for (auto mesh : meshes)
+    {
+        std::vector<Mirage::Vertex> vertices;
+        std::vector<GLuint> indices;
+        Mirage::Mesh::extract(mesh, vertices, indices);
+
+        // Collect Diffuse and Specular Texture References
+        std::vector<Mirage::BundleReference> references;
+        aiMaterial * material = scene->mMaterials[mesh->mMaterialIndex];
+        aiTextureType types[] = { aiTextureType_DIFFUSE, aiTextureType_SPECULAR };
+        for (unsigned int t = 0; t < 2; t++)
+        for (unsigned int i = 0; i < material->GetTextureCount(types[t]); i++)
+        {
+            aiString str; material->GetTexture(types[t], i, & str);
+            std::string texture = path + "/" + str.C_Str();
+            if (!packed[texture] && !packTexture(writer, texture)) continue;
+            packed[texture] = true;
+
+            Mirage::BundleReference reference = {};
+            std::strncpy(reference.name, texture.c_str(), sizeof(reference.name) - 1);
+            reference.mode = t;
+            references.push_back(reference);
+        }
+
+        Mirage::BundleRecord record = {};
+        record.vertices = vertices.size();
+        record.indices  = indices.size();
+        record.textures = references.size();
+        append(blob, & record, 1);
+        append(blob, vertices.data(), vertices.size());
+        append(blob, indices.data(), indices.size());
+        append(blob, references.data(), references.size());
+    }
+
+    writer.add(name, Mirage::BundleMesh, meshes.size(), std::move(blob));
+    return true;
+}
+
+// Store GLSL Source Verbatim
+bool packShader(Mirage::BundleWriter & writer, std::string const & name)
+{
+    std::ifstream fd(PROJECT_SOURCE_DIR "/Mirage/Shaders/" + name, std::ios::binary);
+    if (!fd) { fprintf(stderr, "%s %s\n", "Failed to Load Shader", name.c_str()); return false; }
+    std::vector<char> blob((std::istreambuf_iterator<char>(fd)),
+                            std::istreambuf_iterator<char>());
+    writer.add(name, Mirage::BundleShader, 1, std::move(blob));
+    return true;
+}
+
+int main(int argc, char * argv[]) {
+
+    // Check for Valid Arguments
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s name.bundle [model | shader] ...\n", argv[0]);
+        fprintf(stderr, "Writes Mirage/Bundles/name.bundle, Where Mirage::Bundle Looks for It\n");
+        return EXIT_FAILURE;
+    }
+
+    // Sort Inputs by Extension, Matching Shader::create
+    Mirage::BundleWriter writer;
+    std::map<std::string, bool> packed;
+    bool success = true;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string name = argv[i];
+        auto ext = name.substr(name.rfind(".") + 1);
+        if (ext == "comp" || ext == "frag" || ext == "geom" || ext == "vert")
+             success &= packShader(writer, name);
+        else success &= packModel(writer, name, packed);
+    }
+
+    // Write the Bundle Even if Some Inputs Failed, but Report It
+    if (!writer.write(argv[1])) return EXIT_FAILURE;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
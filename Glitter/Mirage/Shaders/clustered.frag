@@ -0,0 +1,76 @@
+#version 430 core
+
+// Lights are Stored in View Space by Mirage::Lighting
+struct Light {
+    vec3  position;
+    float radius;
+    vec3  color;
+    float intensity;
+    uint  shadow;
+};
+
+layout (std430, binding = 0) readonly buffer Lights   { Light lights[];   };
+layout (std430, binding = 1) readonly buffer Clusters { uvec2 clusters[]; };
+layout (std430, binding = 2) readonly buffer Indices  { uint  indices[];  };
+
+uniform uvec3 clusterGrid;
+uniform vec2  tileSize;
+uniform float sliceScale;
+uniform float sliceBias;
+uniform sampler2D diffuse;
+uniform sampler2D specular;
+
+// Atlas-Space Matrices from Mirage::Shadows; a High Default Unit Keeps the Shadow
+// Sampler Off the Units Meshes Bind Their Textures To
+layout (binding = 15) uniform sampler2DShadow shadowAtlas;
+uniform int  shadowCount;
+uniform mat4 shadowMatrices[16];
+uniform mat4 view;
+
+in vec3 worldPosition;
+in vec3 viewPosition;
+in vec3 viewNormal;
+in vec2 texCoord;
+out vec4 color;
+
+// Point Lights Shadow Through the Cube Face Facing the Fragment, in Shadows::point Order
+float shadow(Light light)
+{
+    int first = int(light.shadow) - 1;
+    if (first < 0 || first + 6 > shadowCount) return 1.0;
+    vec3 d = transpose(mat3(view)) * (viewPosition - light.position);
+    vec3 a = abs(d);
+    int face = a.x >= a.y && a.x >= a.z ? (d.x > 0.0 ? 0 : 1)
+             : a.y >= a.z               ? (d.y > 0.0 ? 2 : 3)
+             :                            (d.z > 0.0 ? 4 : 5);
+    vec4 position = shadowMatrices[first + face] * vec4(worldPosition, 1.0);
+    return texture(shadowAtlas, position.xyz / position.w);
+}
+
+void main()
+{
+    // Find this Fragment's Cluster; Only its Lights are Shaded
+    uint slice = uint(clamp(log(-viewPosition.z) * sliceScale + sliceBias,
+                            0.0, float(clusterGrid.z - 1u)));
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / tileSize), clusterGrid.xy - 1u);
+    uvec2 range = clusters[(slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x];
+
+    vec3 albedo = texture(diffuse,  texCoord).rgb;
+    float gloss = texture(specular, texCoord).r;
+    vec3 n = normalize(viewNormal);
+    vec3 v = normalize(-viewPosition);
+    vec3 radiance = vec3(0.0);
+    for (uint i = range.x; i < range.x + range.y; i++)
+    {
+        Light light = lights[indices[i]];
+        vec3 l = light.position - viewPosition;
+        float d = length(l); l /= d;
+        float falloff = clamp(1.0 - d / light.radius, 0.0, 1.0);
+        falloff *= falloff;
+        vec3 h = normalize(l + v);
+        float lambert = max(dot(n, l), 0.0);
+        float phong   = pow(max(dot(n, h), 0.0), 32.0) * gloss;
+        radiance += (albedo * lambert + phong) * light.color * light.intensity * falloff * shadow(light);
+    }
+    color = vec4(radiance, 1.0);
+}
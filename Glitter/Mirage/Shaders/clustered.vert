@@ -0,0 +1,23 @@
+#version 430 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 uv;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 worldPosition;
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    vec4 world    = model * vec4(position, 1.0);
+    worldPosition = vec3(world);
+    viewPosition  = vec3(view * world);
+    viewNormal    = mat3(view * model) * normal;
+    texCoord      = uv;
+    gl_Position   = projection * vec4(viewPosition, 1.0);
+}
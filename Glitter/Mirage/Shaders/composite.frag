@@ -0,0 +1,19 @@
+#version 420 core
+
+// Targets Written by transparent.frag
+layout (binding = 0) uniform sampler2D accumulation;
+layout (binding = 1) uniform sampler2D revealage;
+
+out vec4 color;
+
+void main()
+{
+    // Fully Revealed Pixels Had No Transparent Coverage
+    ivec2 texel  = ivec2(gl_FragCoord.xy);
+    float reveal = texelFetch(revealage, texel, 0).r;
+    if (reveal >= 1.0) discard;
+
+    // Weighted Average Color, Blended over the Opaque Image by Coverage
+    vec4 sum = texelFetch(accumulation, texel, 0);
+    color = vec4(sum.rgb / max(sum.a, 1e-5), reveal);
+}
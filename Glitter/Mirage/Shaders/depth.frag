@@ -0,0 +1,6 @@
+#version 330 core
+
+// Depth-Only Pass; No Color Attachments are Written
+void main()
+{
+}
@@ -0,0 +1,25 @@
+#version 460 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 uv;
+
+// Instance Transforms Written by Mirage::Batch; Each Command's baseInstance Picks One
+struct Instance { mat4 model; uint object; };
+layout (std430, binding = 4) readonly buffer Instances { Instance instances[]; };
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    mat4 model   = instances[gl_BaseInstance].model;
+    vec4 world   = model * vec4(position, 1.0);
+    viewPosition = vec3(view * world);
+    viewNormal   = mat3(view * model) * normal;
+    texCoord     = uv;
+    gl_Position  = projection * vec4(viewPosition, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 430 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 uv;
+
+// World Matrices Uploaded by Mirage::Scene::bind, Indexed by Node; Meshes Without a
+// Node Pass -1 and Their Own Model Matrix
+layout (std430, binding = 5) readonly buffer Transforms { mat4 transforms[]; };
+
+uniform int  node;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    mat4 toWorld = node >= 0 ? transforms[node] : model;
+    vec4 world   = toWorld * vec4(position, 1.0);
+    viewPosition = vec3(view * world);
+    viewNormal   = mat3(view * toWorld) * normal;
+    texCoord     = uv;
+    gl_Position  = projection * vec4(viewPosition, 1.0);
+}
@@ -0,0 +1,30 @@
+#version 430 core
+layout (location = 0) in vec3  position;
+layout (location = 1) in vec3  normal;
+layout (location = 2) in vec2  uv;
+layout (location = 3) in uvec4 bones;
+layout (location = 4) in vec4  weights;
+
+// Matrix Palette Uploaded by Mirage::Animator::bind
+layout (std430, binding = 3) readonly buffer Palette { mat4 palette[]; };
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    mat4 skin = palette[bones.x] * weights.x
+              + palette[bones.y] * weights.y
+              + palette[bones.z] * weights.z
+              + palette[bones.w] * weights.w;
+    vec4 world   = model * skin * vec4(position, 1.0);
+    viewPosition = vec3(view * world);
+    viewNormal   = mat3(view * model * skin) * normal;
+    texCoord     = uv;
+    gl_Position  = projection * vec4(viewPosition, 1.0);
+}
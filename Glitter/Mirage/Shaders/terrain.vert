@@ -0,0 +1,31 @@
+#version 330 core
+layout (location = 0) in vec2 grid;
+layout (location = 1) in vec2 heights;
+layout (location = 2) in vec3 normal;
+
+// Set per Chunk by Mirage::Terrain::draw
+uniform vec3 chunk;   // World x and z of the Chunk's Corner, Then its Sample Spacing
+uniform vec2 morph;   // Distance Where Morphing Starts, and One Over its Length
+uniform vec3 camera;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    // Measure from the Unmorphed Vertex so the Morph Cannot Feed Back into Itself
+    vec3 world = vec3(chunk.x + grid.x * chunk.z, heights.x, chunk.y + grid.y * chunk.z);
+    float k = clamp((distance(world, camera) - morph.x) * morph.y, 0.0, 1.0);
+
+    // Slide Odd Vertices onto the Parent Grid; Fully Morphed Edges Match a Coarser Neighbour
+    vec2 snapped = grid - fract(grid * 0.5) * 2.0 * k;
+    world = vec3(chunk.x + snapped.x * chunk.z, mix(heights.x, heights.y, k),
+                 chunk.y + snapped.y * chunk.z);
+    viewPosition = vec3(view * vec4(world, 1.0));
+    viewNormal   = mat3(view) * normal;
+    texCoord     = world.xz;
+    gl_Position  = projection * vec4(viewPosition, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+// Lit from the Camera so Every View Reads Well Without Placing Lights
+uniform sampler2D diffuse;
+uniform bool textured;
+
+in vec3 viewNormal;
+in vec2 texCoord;
+out vec4 color;
+
+void main()
+{
+    vec3 albedo = textured ? texture(diffuse, texCoord).rgb : vec3(0.8);
+    float light = abs(normalize(viewNormal).z);
+    color = vec4(albedo * (0.25 + 0.75 * light), 1.0);
+}
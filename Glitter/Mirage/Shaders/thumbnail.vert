@@ -0,0 +1,17 @@
+#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 uv;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 viewNormal;
+out vec2 texCoord;
+
+void main()
+{
+    viewNormal  = mat3(view) * normal;
+    texCoord    = uv;
+    gl_Position = projection * view * vec4(position, 1.0);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+// Weighted-Blended Order-Independent Transparency (McGuire and Bavoil 2013)
+uniform vec4 tint;
+
+in vec3 viewPosition;
+in vec3 viewNormal;
+in vec2 texCoord;
+
+layout (location = 0) out vec4  accumulation;
+layout (location = 1) out float revealage;
+
+void main()
+{
+    // Simple Headlight Shading; Glass Rarely Needs More for a Sample
+    float facing = abs(dot(normalize(viewNormal), normalize(-viewPosition)));
+    vec4 color = vec4(tint.rgb * (0.3 + 0.7 * facing), tint.a);
+
+    // Nearer and More Opaque Surfaces Dominate the Average
+    float weight = clamp(color.a * max(1e-2, 3e3 * pow(1.0 - gl_FragCoord.z, 3.0)), 1e-2, 3e3);
+    accumulation = vec4(color.rgb * color.a, color.a) * weight;
+    revealage    = color.a;
+}
@@ -0,0 +1,457 @@
+// Local Headers
+#include "animation.hpp"
+#include "mesh.hpp"
+
+// Preprocessor Directives
+#if defined(__SSE2__) || defined(_M_X64)
+#define MIRAGE_SSE
+#include <emmintrin.h>
+#endif
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+
+// Define Namespace
+namespace Mirage
+{
+    // Assimp Matrices are Row-Major
+    glm::mat4 convert(aiMatrix4x4 const & m)
+    {
+        return glm::mat4(glm::vec4(m.a1, m.b1, m.c1, m.d1),
+                         glm::vec4(m.a2, m.b2, m.c2, m.d2),
+                         glm::vec4(m.a3, m.b3, m.c3, m.d3),
+                         glm::vec4(m.a4, m.b4, m.c4, m.d4));
+    }
+
+    // Split an Affine Matrix into Translation, Rotation and Scale
+    static Transform decompose(glm::mat4 const & m)
+    {
+        glm::vec3 x = glm::vec3(m[0]), y = glm::vec3(m[1]), z = glm::vec3(m[2]);
+        Transform transform;
+        transform.translation = glm::vec3(m[3]);
+        transform.scale = glm::vec3(glm::length(x), glm::length(y), glm::length(z));
+        glm::mat3 rotation(x / transform.scale.x, y / transform.scale.y, z / transform.scale.z);
+        transform.rotation = glm::quat_cast(rotation);
+        return transform;
+    }
+
+    static glm::mat4 compose(Transform const & t)
+    {
+        glm::mat3 r = glm::mat3_cast(t.rotation);
+        return glm::mat4(glm::vec4(r[0] * t.scale.x, 0.0f),
+                         glm::vec4(r[1] * t.scale.y, 0.0f),
+                         glm::vec4(r[2] * t.scale.z, 0.0f),
+                         glm::vec4(t.translation, 1.0f));
+    }
+
+    void multiply(glm::mat4 const & a, glm::mat4 const & b, glm::mat4 & out)
+    {
+#ifdef MIRAGE_SSE
+        __m128 a0 = _mm_loadu_ps(& a[0][0]), a1 = _mm_loadu_ps(& a[1][0]);
+        __m128 a2 = _mm_loadu_ps(& a[2][0]), a3 = _mm_loadu_ps(& a[3][0]);
+        __m128 columns[4];
+        for (int j = 0; j < 4; j++)
+        {
+            __m128 column = _mm_mul_ps(a0, _mm_set1_ps(b[j][0]));
+            column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(b[j][1])));
+            column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(b[j][2])));
+            column = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(b[j][3])));
+            columns[j] = column;
+        }
+        for (int j = 0; j < 4; j++) _mm_storeu_ps(& out[j][0], columns[j]);
+#else
+        out = a * b;
+#endif
+    }
+
+    static glm::quat nlerp(glm::quat const & a, glm::quat b, float weight)
+    {
+        if (glm::dot(a, b) < 0.0f) b = -b;
+        return glm::normalize(a * (1.0f - weight) + b * weight);
+    }
+
+    Skeleton::Skeleton(aiScene const * scene)
+        : mInverseRoot(glm::inverse(convert(scene->mRootNode->mTransformation)))
+    {
+        // Flatten the Node Tree Depth-First so Parents Precede Children
+        std::vector<std::pair<aiNode const *, int>> stack = { { scene->mRootNode, -1 } };
+        while (!stack.empty())
+        {
+            auto node = stack.back(); stack.pop_back();
+            int index = add(node.first->mName.C_Str(), node.second,
+                            convert(node.first->mTransformation));
+            for (unsigned int i = node.first->mNumChildren; i > 0; i--)
+                stack.push_back(std::make_pair(node.first->mChildren[i - 1], index));
+        }
+    }
+
+    int Skeleton::add(std::string const & name, int parent, glm::mat4 const & bind)
+    {
+        Joint joint = { name, parent, decompose(bind), glm::mat4(1.0f) };
+        mJoints.push_back(joint);
+        return mJoints.size() - 1;
+    }
+
+    int Skeleton::find(std::string const & name) const
+    {
+        for (std::size_t i = 0; i < mJoints.size(); i++)
+            if (mJoints[i].name == name) return i;
+        return -1;
+    }
+
+    Clip::Clip(Skeleton const & skeleton, float duration, float rate,
+               std::function<Transform(int joint, float time)> const & source)
+        : mDuration(duration)
+        , mRate(rate)
+    {
+        build(skeleton, source);
+    }
+
+    Clip::Clip(Skeleton const & skeleton, aiAnimation const * animation, float rate)
+        : mName(animation->mName.C_Str())
+        , mRate(rate)
+    {
+        double ticks = animation->mTicksPerSecond != 0.0 ? animation->mTicksPerSecond : 25.0;
+        mDuration = static_cast<float>(animation->mDuration / ticks);
+
+        // Match Channels to Joints by Node Name
+        std::vector<aiNodeAnim const *> channels(skeleton.joints().size(), nullptr);
+        for (unsigned int i = 0; i < animation->mNumChannels; i++)
+        {
+            int joint = skeleton.find(animation->mChannels[i]->mNodeName.C_Str());
+            if (joint >= 0) channels[joint] = animation->mChannels[i];
+        }
+
+        // Interpolate Between the Two Keys Bracketing a Time
+        auto bracket = [](double time, double first, double second, double & weight)
+        {   weight = second > first ? (time - first) / (second - first) : 0.0;
+            weight = std::min(1.0, std::max(0.0, weight));
+        };
+        build(skeleton, [&](int joint, float seconds) -> Transform
+        {
+            auto channel = channels[joint];
+            if (!channel) return skeleton.joints()[joint].bind;
+            double time = seconds * ticks, weight;
+            Transform transform;
+
+            unsigned int i = 0;
+            while (i + 1 < channel->mNumPositionKeys && channel->mPositionKeys[i + 1].mTime <= time) i++;
+            unsigned int j = std::min(i + 1, channel->mNumPositionKeys - 1);
+            bracket(time, channel->mPositionKeys[i].mTime, channel->mPositionKeys[j].mTime, weight);
+            auto & p0 = channel->mPositionKeys[i].mValue; auto & p1 = channel->mPositionKeys[j].mValue;
+            transform.translation = glm::mix(glm::vec3(p0.x, p0.y, p0.z), glm::vec3(p1.x, p1.y, p1.z), static_cast<float>(weight));
+
+            i = 0;
+            while (i + 1 < channel->mNumRotationKeys && channel->mRotationKeys[i + 1].mTime <= time) i++;
+            j = std::min(i + 1, channel->mNumRotationKeys - 1);
+            bracket(time, channel->mRotationKeys[i].mTime, channel->mRotationKeys[j].mTime, weight);
+            auto & r0 = channel->mRotationKeys[i].mValue; auto & r1 = channel->mRotationKeys[j].mValue;
+            transform.rotation = glm::slerp(glm::quat(r0.w, r0.x, r0.y, r0.z),
+                                            glm::quat(r1.w, r1.x, r1.y, r1.z), static_cast<float>(weight));
+
+            i = 0;
+            while (i + 1 < channel->mNumScalingKeys && channel->mScalingKeys[i + 1].mTime <= time) i++;
+            j = std::min(i + 1, channel->mNumScalingKeys - 1);
+            bracket(time, channel->mScalingKeys[i].mTime, channel->mScalingKeys[j].mTime, weight);
+            auto & s0 = channel->mScalingKeys[i].mValue; auto & s1 = channel->mScalingKeys[j].mValue;
+            transform.scale = glm::mix(glm::vec3(s0.x, s0.y, s0.z), glm::vec3(s1.x, s1.y, s1.z), static_cast<float>(weight));
+            return transform;
+        });
+    }
+
+    void Clip::build(Skeleton const & skeleton,
+                     std::function<Transform(int joint, float time)> const & source)
+    {
+        // Resample Every Joint at a Fixed Rate
+        mJoints = skeleton.joints().size();
+        mFrames = std::max(1, static_cast<int>(std::ceil(mDuration * mRate)) + 1);
+        std::vector<Transform> samples(mFrames * mJoints);
+        for (int f = 0; f < mFrames; f++)
+        for (int j = 0; j < mJoints; j++)
+            samples[f * mJoints + j] = source(j, std::min(mDuration, f / mRate));
+
+        // Find Per-Joint Ranges so Translation and Scale Use the Full 16 Bits
+        mRanges.resize(mJoints);
+        for (int j = 0; j < mJoints; j++)
+        {
+            glm::vec3 tMin = samples[j].translation, tMax = tMin;
+            glm::vec3 sMin = samples[j].scale,       sMax = sMin;
+            for (int f = 1; f < mFrames; f++)
+            {
+                auto & sample = samples[f * mJoints + j];
+                tMin = glm::min(tMin, sample.translation); tMax = glm::max(tMax, sample.translation);
+                sMin = glm::min(sMin, sample.scale);       sMax = glm::max(sMax, sample.scale);
+            }
+            Range range = { tMin, tMax - tMin, sMin, sMax - sMin };
+            mRanges[j] = range;
+        }
+
+        // Quantize; Rotations are Kept in One Hemisphere Between Neighbouring Frames
+        auto unsigned16 = [](float value, float lo, float extent)
+        {   return static_cast<std::uint16_t>(extent > 0.0f ? std::lround((value - lo) / extent * 65535.0f) : 0);
+        };
+        auto signed16 = [](float value)
+        {   return static_cast<std::int16_t>(std::lround(glm::clamp(value, -1.0f, 1.0f) * 32767.0f));
+        };
+        mKeys.resize(mFrames * mJoints);
+        for (int f = 0; f < mFrames; f++)
+        for (int j = 0; j < mJoints; j++)
+        {
+            auto & sample = samples[f * mJoints + j];
+            auto & range = mRanges[j];
+            glm::quat rotation = glm::normalize(sample.rotation);
+            if (f > 0 && glm::dot(rotation, samples[(f - 1) * mJoints + j].rotation) < 0.0f)
+                rotation = -rotation;
+            sample.rotation = rotation;
+
+            Key & key = mKeys[f * mJoints + j];
+            for (int k = 0; k < 3; k++)
+            {
+                key.translation[k] = unsigned16(sample.translation[k], range.translation[k], range.translationExtent[k]);
+                key.scale[k]       = unsigned16(sample.scale[k], range.scale[k], range.scaleExtent[k]);
+            }
+            key.rotation[0] = signed16(rotation.x);
+            key.rotation[1] = signed16(rotation.y);
+            key.rotation[2] = signed16(rotation.z);
+            key.rotation[3] = signed16(rotation.w);
+        }
+    }
+
+    void Clip::sample(float time, std::vector<Transform> & pose) const
+    {
+        // Loop, Then Find the Two Frames Around the Time
+        if (mDuration > 0.0f)
+        {   time = std::fmod(time, mDuration);
+            if (time < 0.0f) time += mDuration;
+        }
+        float frame = time * mRate;
+        int f0 = std::min(mFrames - 1, static_cast<int>(frame));
+        int f1 = std::min(mFrames - 1, f0 + 1);
+        float weight = frame - f0;
+
+        pose.resize(mJoints);
+        Key const * a = & mKeys[f0 * mJoints];
+        Key const * b = & mKeys[f1 * mJoints];
+        for (int j = 0; j < mJoints; j++)
+        {
+            auto & range = mRanges[j];
+            for (int k = 0; k < 3; k++)
+            {
+                float t0 = a[j].translation[k], t1 = b[j].translation[k];
+                float s0 = a[j].scale[k],       s1 = b[j].scale[k];
+                pose[j].translation[k] = range.translation[k] + (t0 + (t1 - t0) * weight) / 65535.0f * range.translationExtent[k];
+                pose[j].scale[k]       = range.scale[k]       + (s0 + (s1 - s0) * weight) / 65535.0f * range.scaleExtent[k];
+            }
+            glm::quat r0(a[j].rotation[3] / 32767.0f, a[j].rotation[0] / 32767.0f,
+                         a[j].rotation[1] / 32767.0f, a[j].rotation[2] / 32767.0f);
+            glm::quat r1(b[j].rotation[3] / 32767.0f, b[j].rotation[0] / 32767.0f,
+                         b[j].rotation[1] / 32767.0f, b[j].rotation[2] / 32767.0f);
+            pose[j].rotation = nlerp(r0, r1, weight);
+        }
+    }
+
+    void blend(std::vector<Transform> const & a, std::vector<Transform> const & b,
+               float weight, std::vector<Transform> & out)
+    {
+        out.resize(a.size());
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            out[i].translation = glm::mix(a[i].translation, b[i].translation, weight);
+            out[i].rotation    = nlerp(a[i].rotation, b[i].rotation, weight);
+            out[i].scale       = glm::mix(a[i].scale, b[i].scale, weight);
+        }
+    }
+
+    void palette(Skeleton const & skeleton, std::vector<Transform> const & pose,
+                 std::vector<glm::mat4> & out)
+    {
+        // Globals are Resolved in One Forward Pass, Then Moved into Bind Space
+        auto & joints = skeleton.joints();
+        thread_local std::vector<glm::mat4> globals;
+        globals.resize(joints.size());
+        out.resize(joints.size());
+        for (std::size_t i = 0; i < joints.size(); i++)
+        {
+            globals[i] = compose(pose[i]);
+            if (joints[i].parent >= 0) multiply(globals[joints[i].parent], globals[i], globals[i]);
+            multiply(skeleton.inverseRoot(), globals[i], out[i]);
+            multiply(out[i], joints[i].inverseBind, out[i]);
+        }
+    }
+
+    void skin(Vertex const * vertices, Influence const * influences, std::size_t count,
+              std::vector<glm::mat4> const & palette, Vertex * out)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            auto & influence = influences[i];
+            auto & vertex = vertices[i];
+#ifdef MIRAGE_SSE
+            // Blend the Four Bone Matrices Column by Column
+            __m128 columns[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+            for (int k = 0; k < 4; k++)
+            {
+                if (influence.weights[k] == 0.0f) continue;
+                __m128 weight = _mm_set1_ps(influence.weights[k]);
+                auto & bone = palette[influence.bones[k]];
+                for (int c = 0; c < 4; c++)
+                    columns[c] = _mm_add_ps(columns[c], _mm_mul_ps(weight, _mm_loadu_ps(& bone[c][0])));
+            }
+            __m128 position = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(columns[0], _mm_set1_ps(vertex.position.x)),
+                _mm_mul_ps(columns[1], _mm_set1_ps(vertex.position.y))),
+                _mm_add_ps(_mm_mul_ps(columns[2], _mm_set1_ps(vertex.position.z)), columns[3]));
+            __m128 normal = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(columns[0], _mm_set1_ps(vertex.normal.x)),
+                _mm_mul_ps(columns[1], _mm_set1_ps(vertex.normal.y))),
+                _mm_mul_ps(columns[2], _mm_set1_ps(vertex.normal.z)));
+            __m128 tangent = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(columns[0], _mm_set1_ps(vertex.tangent.x)),
+                _mm_mul_ps(columns[1], _mm_set1_ps(vertex.tangent.y))),
+                _mm_mul_ps(columns[2], _mm_set1_ps(vertex.tangent.z)));
+            float p[4], n[4], t[4];
+            _mm_storeu_ps(p, position);
+            _mm_storeu_ps(n, normal);
+            _mm_storeu_ps(t, tangent);
+            out[i].position = glm::vec3(p[0], p[1], p[2]);
+            out[i].normal   = glm::vec3(n[0], n[1], n[2]);
+            glm::vec3 skinned(t[0], t[1], t[2]);
+#else
+            glm::mat4 bone(0.0f);
+            for (int k = 0; k < 4; k++)
+                if (influence.weights[k] != 0.0f)
+                    bone = bone + palette[influence.bones[k]] * influence.weights[k];
+            out[i].position = glm::vec3(bone * glm::vec4(vertex.position, 1.0f));
+            out[i].normal   = glm::vec3(bone * glm::vec4(vertex.normal, 0.0f));
+            glm::vec3 skinned(bone * glm::vec4(glm::vec3(vertex.tangent), 0.0f));
+#endif
+            float length = glm::length(out[i].normal);
+            if (length > 0.0f) out[i].normal /= length;
+            length = glm::length(skinned);
+            if (length > 0.0f) skinned /= length;
+            out[i].uv = vertex.uv;
+
+            // Handedness Survives Skinning Since Bones Do Not Mirror
+            out[i].tangent = glm::vec4(skinned.x, skinned.y, skinned.z, vertex.tangent.w);
+        }
+    }
+
+    void weigh(std::vector<BoneWeight> const & weights, std::vector<GLuint> const & remap,
+               std::size_t count, std::vector<Influence> & out)
+    {
+        // Welded Duplicates Carry the Same Weights, so Only the First Imported Vertex Counts
+        std::vector<GLuint> source(count, ~0u);
+        for (GLuint i = 0; i < remap.size(); i++)
+            if (remap[i] < count && source[remap[i]] == ~0u) source[remap[i]] = i;
+
+        // Keep the Four Strongest Bone Weights per Vertex
+        Influence blank = { { 0, 0, 0, 0 }, glm::vec4(0.0f) };
+        out.assign(count, blank);
+        for (auto & weight : weights)
+        {
+            if (weight.vertex >= remap.size() || remap[weight.vertex] >= count) continue;
+            if (source[remap[weight.vertex]] != weight.vertex) continue;
+            auto & influence = out[remap[weight.vertex]];
+            int weakest = 0;
+            for (int k = 1; k < 4; k++)
+                if (influence.weights[k] < influence.weights[weakest]) weakest = k;
+            if (weight.weight <= influence.weights[weakest]) continue;
+            influence.bones[weakest]   = weight.joint;
+            influence.weights[weakest] = weight.weight;
+        }
+        for (auto & influence : out)
+        {   float total = influence.weights.x + influence.weights.y + influence.weights.z + influence.weights.w;
+            if (total > 0.0f) influence.weights /= total;
+        }
+    }
+
+    Animator::Animator(unsigned int threads)
+        : mNext(0)
+        , mGeneration(0)
+        , mBusy(0)
+        , mQuit(false)
+        , mSkeleton(nullptr)
+        , mCharacters(nullptr)
+        , mBuffer(0)
+    {
+        // The Calling Thread Also Works, so Spawn One Fewer
+        for (unsigned int i = 1; i < threads; i++)
+            mThreads.push_back(std::thread(& Animator::work, this));
+    }
+
+    Animator::~Animator()
+    {
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }   mStart.notify_all();
+        for (auto & thread : mThreads) thread.join();
+        if (mBuffer) glDeleteBuffers(1, & mBuffer);
+    }
+
+    void Animator::update(Skeleton const & skeleton, std::vector<Character> & characters)
+    {
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            mSkeleton   = & skeleton;
+            mCharacters = & characters;
+            mNext       = 0;
+            mBusy       = mThreads.size();
+            mGeneration++;
+        }   mStart.notify_all();
+
+        drain();
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mBusy == 0; });
+    }
+
+    void Animator::bind(Character const & character)
+    {
+        if (!mBuffer) glGenBuffers(1, & mBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, character.palette.size() * sizeof(glm::mat4),
+                     character.palette.data(), GL_STREAM_DRAW);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, mBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    void Animator::work()
+    {
+        std::size_t seen = 0;
+        for (;;)
+        {
+            {   std::unique_lock<std::mutex> lock(mMutex);
+                mStart.wait(lock, [&] { return mQuit || mGeneration != seen; });
+                if (mQuit) return;
+                seen = mGeneration;
+            }
+
+            drain();
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mBusy == 0) mDone.notify_one();
+        }
+    }
+
+    void Animator::drain()
+    {
+        // Claim Small Batches so Uneven Clips Still Balance Across Threads
+        const std::size_t batch = 32;
+        thread_local std::vector<Transform> a, b;
+        auto & characters = *mCharacters;
+        for (;;)
+        {
+            std::size_t begin = mNext.fetch_add(batch);
+            if (begin >= characters.size()) return;
+            std::size_t end = std::min(begin + batch, characters.size());
+            for (std::size_t i = begin; i < end; i++)
+            {
+                auto & character = characters[i];
+                character.clips[0]->sample(character.times[0], a);
+                if (character.clips[1] && character.weight > 0.0f)
+                {   character.clips[1]->sample(character.times[1], b);
+                    blend(a, b, character.weight, a);
+                }
+                palette(*mSkeleton, a, character.palette);
+            }
+        }
+    }
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+// System Headers
+#include <assimp/scene.h>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Standard Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Forward Declarations
+    struct Vertex;
+
+    // Per-Vertex Skinning Data, Stored in a Separate Vertex Stream
+    struct Influence {
+        GLushort  bones[4];
+        glm::vec4 weights;
+    };
+
+    // A Single Bone Weight on an Imported Vertex, Before Welding
+    struct BoneWeight {
+        GLuint   vertex;
+        GLushort joint;
+        float    weight;
+    };
+
+    // Decomposed Local Joint Transform
+    struct Transform {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+    };
+
+    // Joints are Stored Parents-First so a Single Forward Pass Resolves the Hierarchy
+    struct Joint {
+        std::string name;
+        int         parent;
+        Transform   bind;
+        glm::mat4   inverseBind;
+    };
+
+    class Skeleton
+    {
+    public:
+
+        // Implement Custom Constructors
+        Skeleton() : mInverseRoot(1.0f) {}
+        Skeleton(aiScene const * scene);
+
+        // Public Member Functions
+        int  add(std::string const & name, int parent, glm::mat4 const & bind);
+        int  find(std::string const & name) const;
+        void bind(int joint, glm::mat4 const & inverseBind) { mJoints[joint].inverseBind = inverseBind; }
+
+        // Public Accessors
+        std::vector<Joint> const & joints() const { return mJoints; }
+        glm::mat4 const & inverseRoot() const { return mInverseRoot; }
+
+    private:
+
+        // Private Member Variables
+        std::vector<Joint> mJoints;
+        glm::mat4 mInverseRoot;
+
+    };
+
+    class Clip
+    {
+    public:
+
+        // Resample Any Source at a Fixed Rate so Playback Never Searches for Keys
+        Clip(Skeleton const & skeleton, float duration, float rate,
+             std::function<Transform(int joint, float time)> const & source);
+        Clip(Skeleton const & skeleton, aiAnimation const * animation, float rate = 30.0f);
+
+        // Public Member Functions
+        void sample(float time, std::vector<Transform> & pose) const;
+
+        // Public Accessors
+        std::string const & name() const { return mName; }
+        float duration() const { return mDuration; }
+        std::size_t bytes() const { return mKeys.size() * sizeof(Key) + mRanges.size() * sizeof(Range); }
+
+    private:
+
+        // Quantized Key: Translation and Scale are Normalized to a Per-Joint Range
+        struct Key {
+            std::uint16_t translation[3];
+            std::int16_t  rotation[4];
+            std::uint16_t scale[3];
+        };
+
+        // Per-Joint Dequantization Range
+        struct Range {
+            glm::vec3 translation, translationExtent;
+            glm::vec3 scale, scaleExtent;
+        };
+
+        // Private Member Functions
+        void build(Skeleton const & skeleton,
+                   std::function<Transform(int joint, float time)> const & source);
+
+        // Keys are Frame-Major so Sampling Touches Two Contiguous Rows
+        std::vector<Key>   mKeys;
+        std::vector<Range> mRanges;
+
+        // Private Member Variables
+        std::string mName;
+        float mDuration;
+        float mRate;
+        int   mFrames;
+        int   mJoints;
+
+    };
+
+    // An Animated Instance: Two Clips Crossfaded by Weight
+    struct Character {
+        Clip const * clips[2];
+        float        times[2];
+        float        weight;
+        std::vector<glm::mat4> palette;
+    };
+
+    // Convert Assimp's Row-Major Matrices
+    glm::mat4 convert(aiMatrix4x4 const & matrix);
+
+    // Column-Major 4x4 Multiply, with SSE Where Available; Safe When out Aliases Either Input
+    void multiply(glm::mat4 const & a, glm::mat4 const & b, glm::mat4 & out);
+
+    // Pose Operations
+    void blend(std::vector<Transform> const & a, std::vector<Transform> const & b,
+               float weight, std::vector<Transform> & out);
+    void palette(Skeleton const & skeleton, std::vector<Transform> const & pose,
+                 std::vector<glm::mat4> & out);
+    void skin(Vertex const * vertices, Influence const * influences, std::size_t count,
+              std::vector<glm::mat4> const & palette, Vertex * out);
+
+    // Keep the Four Strongest Normalized Weights of Each of count Welded Vertices. remap
+    // Takes Imported Vertices to Welded Ones; Only the First Imported Vertex of Each
+    // Welded Vertex Contributes, so Corners Merged by Welding are Not Counted Twice
+    void weigh(std::vector<BoneWeight> const & weights, std::vector<GLuint> const & remap,
+               std::size_t count, std::vector<Influence> & out);
+
+    class Animator
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Animator(unsigned int threads = std::thread::hardware_concurrency());
+        ~Animator();
+
+        // Sample, Blend and Build Palettes for Every Character in Parallel
+        void update(Skeleton const & skeleton, std::vector<Character> & characters);
+
+        // Upload a Palette for skinned.vert
+        void bind(Character const & character);
+
+    private:
+
+        // Disable Copying and Assignment
+        Animator(Animator const &) = delete;
+        Animator & operator=(Animator const &) = delete;
+
+        // Private Member Functions
+        void work();
+        void drain();
+
+        // Worker Threads and Their Hand-Off State
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mStart;
+        std::condition_variable mDone;
+        std::atomic<std::size_t> mNext;
+        std::size_t mGeneration;
+        std::size_t mBusy;
+        bool mQuit;
+
+        // The Batch Currently Being Evaluated
+        Skeleton const * mSkeleton;
+        std::vector<Character> * mCharacters;
+
+        // Private Member Variables
+        GLuint mBuffer;
+
+    };
+};
@@ -0,0 +1,228 @@
+// Local Headers
+#include "batch.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <limits>
+
+// Define Namespace
+namespace Mirage
+{
+    // Buffer Slots, Also the Storage Buffer Bindings Used by cull.comp
+    enum { kInstances, kObjects, kLevels, kDrawables, kRegions, kCommands, kCounts, kVertices, kIndices };
+
+    // indirect.vert Reads Instances Here, Clear of the Lighting and Palette Bindings
+    static const GLuint kInstanceBinding = 4;
+
+    Batch::Batch()
+        : mGeometryDirty(true)
+        , mInstancesDirty(true)
+        , mRegionsDirty(true)
+        , mCommandCapacity(0)
+        , mBuffers()
+    {
+        mCull.attach("cull.comp").link();
+        glGenVertexArrays(1, & mVertexArray);
+        glGenBuffers(9, mBuffers);
+    }
+
+    Batch::~Batch()
+    {
+        glDeleteVertexArrays(1, & mVertexArray);
+        glDeleteBuffers(9, mBuffers);
+    }
+
+    int Batch::add(std::vector<Mesh const *> const & levels, std::vector<float> const & distances)
+    {
+        // Every Level Contributes its Sub-Meshes to the Shared Geometry
+        Object object = {};
+        object.min = glm::vec4( std::numeric_limits<float>::max());
+        object.max = glm::vec4(-std::numeric_limits<float>::max());
+        object.firstLevel = mLevels.size();
+        object.levels = std::min(levels.size(), distances.size());
+        for (GLuint i = 0; i < object.levels; i++)
+        {
+            Level level = {};
+            level.first = mDrawables.size();
+            level.distance = distances[i];
+            gather(levels[i], object);
+            level.count = mDrawables.size() - level.first;
+            mLevels.push_back(level);
+        }
+
+        mObjects.push_back(object);
+        mGeometryDirty = mRegionsDirty = true;
+        return mObjects.size() - 1;
+    }
+
+    void Batch::gather(Mesh const * mesh, Object & object)
+    {
+        for (auto &i : mesh->mSubMeshes) gather(i.get(), object);
+        if (mesh->mCount == 0) return;
+
+        // Meshes Uploaded Straight from a Bundle Keep No CPU Copy to Merge
+        if (mesh->mIndices.empty())
+        {   fprintf(stderr, "%s\n", "Batch Skipped a Mesh Without CPU Geometry");
+            return;
+        }
+
+        // Sub-Meshes Sharing a Texture Set Share a Material
+        auto material = mMaterialIndex.find(mesh->mTextures);
+        if (material == mMaterialIndex.end())
+        {   material = mMaterialIndex.insert(std::make_pair(mesh->mTextures, mMaterials.size())).first;
+            mMaterials.push_back(mesh);
+        }
+
+        Drawable drawable = {};
+        drawable.min = glm::vec4(mesh->mMin, 1.0f);
+        drawable.max = glm::vec4(mesh->mMax, 1.0f);
+        drawable.count = mesh->mIndices.size();
+        drawable.firstIndex = mIndices.size();
+        drawable.baseVertex = mVertices.size();
+        drawable.material = material->second;
+        mDrawables.push_back(drawable);
+        mVertices.insert(mVertices.end(), mesh->mVertices.begin(), mesh->mVertices.end());
+        mIndices.insert(mIndices.end(), mesh->mIndices.begin(), mesh->mIndices.end());
+        object.min = glm::vec4(glm::min(glm::vec3(object.min), mesh->mMin), 1.0f);
+        object.max = glm::vec4(glm::max(glm::vec3(object.max), mesh->mMax), 1.0f);
+    }
+
+    int Batch::instance(int object, glm::mat4 const & model)
+    {
+        Instance instance = {};
+        instance.model  = model;
+        instance.object = object;
+        mInstances.push_back(instance);
+        mInstancesDirty = mRegionsDirty = true;
+        return mInstances.size() - 1;
+    }
+
+    void Batch::move(int instance, glm::mat4 const & model)
+    {
+        mInstances[instance].model = model;
+        mInstancesDirty = true;
+    }
+
+    void Batch::upload()
+    {
+        // Merged Vertex Format Matches Mesh, so Existing Shaders Still Apply
+        glBindVertexArray(mVertexArray);
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[kVertices]);
+        glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(Vertex), mVertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffers[kIndices]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndices.size() * sizeof(GLuint), mIndices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, position));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, uv));
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, tangent));
+        glEnableVertexAttribArray(0); // Vertex Positions
+        glEnableVertexAttribArray(1); // Vertex Normals
+        glEnableVertexAttribArray(2); // Vertex UVs
+        glEnableVertexAttribArray(5); // Vertex Tangents
+        glBindVertexArray(0);
+
+        // Per-Model Tables Only Change When Models are Added
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kObjects]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, mObjects.size() * sizeof(Object), mObjects.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kLevels]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, mLevels.size() * sizeof(Level), mLevels.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kDrawables]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, mDrawables.size() * sizeof(Drawable), mDrawables.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        mGeometryDirty = false;
+    }
+
+    void Batch::allocate()
+    {
+        // Reserve Room for the Worst Case: Each Instance Drawing its Busiest Level
+        std::vector<GLuint> perObject(mObjects.size() * mMaterials.size(), 0);
+        for (std::size_t i = 0; i < mObjects.size(); i++)
+        for (GLuint j = 0; j < mObjects[i].levels; j++)
+        {
+            auto & level = mLevels[mObjects[i].firstLevel + j];
+            std::vector<GLuint> draws(mMaterials.size(), 0);
+            for (GLuint k = 0; k < level.count; k++)
+                draws[mDrawables[level.first + k].material]++;
+            for (std::size_t k = 0; k < draws.size(); k++)
+                perObject[i * mMaterials.size() + k] = std::max(perObject[i * mMaterials.size() + k], draws[k]);
+        }
+
+        // Carve the Command Buffer into One Contiguous Region per Material
+        mRegions.assign(mMaterials.size(), Region());
+        for (auto & instance : mInstances)
+        for (std::size_t k = 0; k < mMaterials.size(); k++)
+            mRegions[k].capacity += perObject[instance.object * mMaterials.size() + k];
+        GLuint offset = 0;
+        for (auto & region : mRegions)
+        {   region.offset = offset;
+            offset += region.capacity;
+        }
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kRegions]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<std::size_t>(mRegions.size(), 1) * sizeof(Region),
+                     mRegions.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kCounts]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<std::size_t>(mRegions.size(), 1) * sizeof(GLuint),
+                     nullptr, GL_DYNAMIC_DRAW);
+        if (offset > mCommandCapacity)
+        {   mCommandCapacity = offset;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kCommands]);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, mCommandCapacity * sizeof(DrawCommand), nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        mRegionsDirty = false;
+    }
+
+    void Batch::cull(glm::mat4 const & view, glm::mat4 const & projection)
+    {
+        if (mGeometryDirty) upload();
+        if (mRegionsDirty)  allocate();
+        if (mInstances.empty()) return;
+        if (mInstancesDirty)
+        {   glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kInstances]);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, mInstances.size() * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, mInstances.size() * sizeof(Instance), mInstances.data());
+            mInstancesDirty = false;
+        }
+
+        // Every Material Starts the Frame with No Commands
+        GLuint zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffers[kCounts]);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, & zero);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        // One Invocation per Instance: Pick a Level, Test its Sub-Meshes, Append Commands
+        glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+        mCull.activate();
+        mCull.bind("viewProjection", projection * view);
+        glUniform3fv(glGetUniformLocation(mCull.get(), "eye"), 1, & eye[0]);
+        glUniform1ui(glGetUniformLocation(mCull.get(), "instanceCount"), mInstances.size());
+        for (GLuint i = kInstances; i <= kCounts; i++)
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, mBuffers[i]);
+        glDispatchCompute((mInstances.size() + 63) / 64, 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    void Batch::draw(GLuint shader)
+    {
+        if (mInstances.empty()) return;
+        glBindVertexArray(mVertexArray);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mBuffers[kCommands]);
+        glBindBuffer(GL_PARAMETER_BUFFER, mBuffers[kCounts]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kInstanceBinding, mBuffers[kInstances]);
+
+        // The GPU Decides How Many of Each Region's Commands Actually Run
+        for (std::size_t i = 0; i < mMaterials.size(); i++)
+        {
+            if (mRegions[i].capacity == 0) continue;
+            mMaterials[i]->textures(shader);
+            glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT,
+                (GLvoid *) (mRegions[i].offset * sizeof(DrawCommand)),
+                i * sizeof(GLuint), mRegions[i].capacity, sizeof(DrawCommand));
+        }
+
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+// Local Headers
+#include "mesh.hpp"
+#include "shader.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <map>
+#include <string>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Command Format Consumed by glMultiDrawElementsIndirectCount
+    struct DrawCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint  baseVertex;
+        GLuint baseInstance;
+    };
+
+    class Batch
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Batch();
+        ~Batch();
+
+        // Register a Model as a Chain of Levels of Detail, Finest First. Level i is
+        // Drawn Up to distances[i] from the Eye; Farther than the Last, Nothing is Drawn
+        int  add(std::vector<Mesh const *> const & levels, std::vector<float> const & distances);
+
+        // Place Instances of a Registered Model; Returns the Instance Index
+        int  instance(int object, glm::mat4 const & model);
+        void move(int instance, glm::mat4 const & model);
+
+        // Cull Every Instance on the GPU and Write Compacted Draw Commands. This
+        // Reuses Storage Bindings 0-6, so Call Lighting::bind Afterwards
+        void cull(glm::mat4 const & view, glm::mat4 const & projection);
+
+        // Submit One Indirect Draw per Material, Regardless of Instance Count
+        void draw(GLuint shader);
+
+        // Public Accessors
+        std::size_t instances() const { return mInstances.size(); }
+        std::size_t materials() const { return mMaterials.size(); }
+
+    private:
+
+        // Disable Copying and Assignment
+        Batch(Batch const &) = delete;
+        Batch & operator=(Batch const &) = delete;
+
+        // Storage Buffer Formats, Matching the std430 Layouts in cull.comp
+        struct Drawable {
+            glm::vec4 min;
+            glm::vec4 max;
+            GLuint    count;
+            GLuint    firstIndex;
+            GLint     baseVertex;
+            GLuint    material;
+        };
+        struct Level {
+            GLuint first;
+            GLuint count;
+            float  distance;
+            GLuint padding;
+        };
+        struct Object {
+            glm::vec4 min;
+            glm::vec4 max;
+            GLuint    firstLevel;
+            GLuint    levels;
+            GLuint    padding[2];
+        };
+        struct Instance {
+            glm::mat4 model;
+            GLuint    object;
+            GLuint    padding[3];
+        };
+        struct Region {
+            GLuint offset;
+            GLuint capacity;
+        };
+
+        // std430 Strides in cull.comp; Levels Carry Explicit Padding Since They Hold No vec4
+        static_assert(sizeof(Drawable)    == 48, "Drawable Must Match cull.comp");
+        static_assert(sizeof(Level)       == 16, "Level Must Match cull.comp");
+        static_assert(sizeof(Object)      == 48, "Object Must Match cull.comp");
+        static_assert(sizeof(Instance)    == 80, "Instance Must Match cull.comp");
+        static_assert(sizeof(DrawCommand) == 20, "DrawCommand Must Match cull.comp");
+
+        // Private Member Functions
+        void gather(Mesh const * mesh, Object & object);
+        void upload();
+        void allocate();
+
+        // Texture Sets in First-Seen Order, Each Drawn with its Own Indirect Call
+        std::map<std::map<GLuint, std::string>, GLuint> mMaterialIndex;
+        std::vector<Mesh const *> mMaterials;
+
+        // Merged Geometry; Sub-Meshes Address it with firstIndex and baseVertex
+        std::vector<Vertex> mVertices;
+        std::vector<GLuint> mIndices;
+
+        // Private Member Containers
+        std::vector<Drawable> mDrawables;
+        std::vector<Level>    mLevels;
+        std::vector<Object>   mObjects;
+        std::vector<Instance> mInstances;
+        std::vector<Region>   mRegions;
+
+        // Private Member Variables
+        Shader mCull;
+        bool   mGeometryDirty;
+        bool   mInstancesDirty;
+        bool   mRegionsDirty;
+        GLuint mCommandCapacity;
+        GLuint mVertexArray;
+        GLuint mBuffers[9];
+
+    };
+};
@@ -0,0 +1,136 @@
+// Local Headers
+#include "bundle.hpp"
+#include "mapping.hpp"
+
+// Standard Headers
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const std::uint32_t kVersion = 2;
+    static const std::uint32_t kAlign   = 4;   // Blobs are Read in Place as Floats and Indices
+
+    // Blob Alignment Must be a Power of Two, and Large Enough to Read Floats in Place
+    static bool aligned(std::uint32_t alignment)
+    {
+        return alignment >= kAlign && (alignment & (alignment - 1)) == 0;
+    }
+
+    Bundle::Bundle(std::string const & filename)
+        : mAddress(nullptr)
+        , mLength(0)
+        , mHeader(nullptr)
+        , mEntries(nullptr)
+    {
+        // Map the Whole File Read-Only so Pages are Shared Between Processes
+        std::string path = PROJECT_SOURCE_DIR "/Mirage/Bundles/" + filename;
+        mAddress = mapFile(path, mLength);
+        if (!mAddress) { fprintf(stderr, "%s %s\n", "Failed to Map Bundle", path.c_str()); return; }
+
+        // Validate the Header and Table of Contents
+        auto header = static_cast<BundleHeader const *>(mAddress);
+        if (mLength < sizeof(BundleHeader)
+            || std::memcmp(header->magic, "MRGB", 4) != 0
+            || header->version != kVersion
+            || !aligned(header->alignment)
+            || mLength < sizeof(BundleHeader) + header->count * sizeof(BundleEntry))
+        {
+            fprintf(stderr, "%s %s\n", "Invalid Bundle", path.c_str());
+            unmap(); return;
+        }
+
+        // Every Blob Must Lie Inside the Mapping, on the Alignment Readers Cast To
+        auto entries = reinterpret_cast<BundleEntry const *>(header + 1);
+        for (std::uint32_t i = 0; i < header->count; i++)
+        if (entries[i].offset > mLength || entries[i].size > mLength - entries[i].offset
+            || entries[i].offset % header->alignment != 0)
+        {
+            fprintf(stderr, "%s %s\n", "Truncated or Misaligned Bundle", path.c_str());
+            unmap(); return;
+        }
+
+        mHeader  = header;
+        mEntries = entries;
+    }
+
+    Bundle::~Bundle() { unmap(); }
+
+    BundleEntry const * Bundle::find(std::string const & name) const
+    {
+        if (!mHeader) return nullptr;
+        for (std::uint32_t i = 0; i < mHeader->count; i++)
+            if (std::strncmp(mEntries[i].name, name.c_str(), sizeof(mEntries[i].name)) == 0)
+                return & mEntries[i];
+        return nullptr;
+    }
+
+    void const * Bundle::data(BundleEntry const & entry) const
+    {
+        return static_cast<char const *>(mAddress) + entry.offset;
+    }
+
+    void Bundle::unmap()
+    {
+        if (!mAddress) return;
+        unmapFile(mAddress, mLength);
+        mAddress = nullptr;
+        mHeader  = nullptr;
+        mEntries = nullptr;
+    }
+
+    void BundleWriter::add(std::string const & name, BundleType type,
+                           std::uint32_t count, std::vector<char> blob)
+    {
+        BundleEntry entry = {};
+        if (name.size() >= sizeof(entry.name))
+            fprintf(stderr, "%s %s\n", "Truncated Bundle Entry Name", name.c_str());
+        std::strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+        entry.type  = type;
+        entry.count = count;
+        entry.size  = blob.size();
+        mEntries.push_back(entry);
+        mBlobs.push_back(std::move(blob));
+    }
+
+    bool BundleWriter::write(std::string const & filename, std::uint32_t alignment) const
+    {
+        if (!aligned(alignment))
+        {   fprintf(stderr, "%s %u\n", "Bundle Alignment Must be a Power of Two of at Least 4, Got", alignment);
+            return false;
+        }
+
+        // Lay Out Blobs After the Table of Contents on Aligned Boundaries
+        auto align = [alignment](std::uint64_t offset)
+        { return (offset + alignment - 1) / alignment * alignment; };
+        std::vector<BundleEntry> entries = mEntries;
+        std::uint64_t offset = sizeof(BundleHeader) + entries.size() * sizeof(BundleEntry);
+        for (auto & entry : entries)
+        {
+            entry.offset = align(offset);
+            offset = entry.offset + entry.size;
+        }
+
+        // Write Header, Table of Contents and Padded Blobs Where Bundle Will Look for Them
+        std::string root = PROJECT_SOURCE_DIR "/Mirage/Bundles";
+        makeDirectory(root);
+        std::string path = root + "/" + filename;
+        std::ofstream fd(path, std::ios::binary);
+        if (!fd) { fprintf(stderr, "%s %s\n", "Failed to Write Bundle", path.c_str()); return false; }
+        BundleHeader header = { { 'M', 'R', 'G', 'B' }, kVersion,
+                                static_cast<std::uint32_t>(entries.size()), alignment };
+        fd.write(reinterpret_cast<char const *>(& header), sizeof(header));
+        fd.write(reinterpret_cast<char const *>(entries.data()), entries.size() * sizeof(BundleEntry));
+        std::uint64_t cursor = sizeof(BundleHeader) + entries.size() * sizeof(BundleEntry);
+        for (std::size_t i = 0; i < entries.size(); i++)
+        {
+            std::vector<char> padding(entries[i].offset - cursor, 0);
+            fd.write(padding.data(), padding.size());
+            fd.write(mBlobs[i].data(), mBlobs[i].size());
+            cursor = entries[i].offset + entries[i].size;
+        }   return static_cast<bool>(fd);
+    }
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+// Standard Headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Bundle Entry Types
+    enum BundleType : std::uint32_t {
+        BundleMesh,
+        BundleTexture,
+        BundleShader
+    };
+
+    // Bundle Header Format
+    struct BundleHeader {
+        char          magic[4];  // Always "MRGB"
+        std::uint32_t version;
+        std::uint32_t count;     // Number of Table of Contents Entries
+        std::uint32_t alignment; // Byte Alignment of Every Blob
+    };
+
+    // Table of Contents Entry Format
+    struct BundleEntry {
+        char          name[104];
+        std::uint32_t type;
+        std::uint32_t count;     // Number of Sub-Meshes for BundleMesh
+        std::uint64_t offset;    // Offset from the Start of the Bundle
+        std::uint64_t size;
+    };
+
+    // Mesh Blob Format: Each Record is Followed by its Vertices, Indices and Texture References
+    struct BundleRecord {
+        std::uint32_t vertices;
+        std::uint32_t indices;
+        std::uint32_t textures;
+        std::uint32_t reserved;
+    };
+
+    // Texture Reference Format
+    struct BundleReference {
+        char          name[120];
+        std::uint32_t mode;      // 0 for Diffuse, 1 for Specular
+        std::uint32_t reserved;
+    };
+
+    // Texture Blob Format: Header is Followed by Decoded Texels
+    struct BundleImage {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t channels;
+        std::uint32_t reserved;
+    };
+
+    class Bundle
+    {
+    public:
+
+        // Map a Bundle into Memory
+         Bundle(std::string const & filename);
+        ~Bundle();
+
+        // Public Member Functions
+        BundleEntry const * find(std::string const & name) const;
+        void const * data(BundleEntry const & entry) const;
+        bool valid() const { return mHeader != nullptr; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Bundle(Bundle const &) = delete;
+        Bundle & operator=(Bundle const &) = delete;
+
+        // Private Member Functions
+        void unmap();
+
+        // Private Member Variables
+        void * mAddress;
+        std::size_t mLength;
+        BundleHeader const * mHeader;
+        BundleEntry const * mEntries;
+
+    };
+
+    class BundleWriter
+    {
+    public:
+
+        // Public Member Functions. Bundles are Written Under Mirage/Bundles, Where Bundle Maps Them.
+        // alignment Must be a Power of Two of at Least 4; Anything Else Fails the Write
+        void add(std::string const & name, BundleType type,
+                 std::uint32_t count, std::vector<char> blob);
+        bool write(std::string const & filename,
+                   std::uint32_t alignment = 4096) const;
+
+    private:
+
+        // Private Member Containers
+        std::vector<BundleEntry> mEntries;
+        std::vector<std::vector<char>> mBlobs;
+
+    };
+};
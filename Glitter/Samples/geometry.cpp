@@ -0,0 +1,357 @@
+// Local Headers
+#include "geometry.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const GLuint      kNone      = ~0u;
+    static const float       kUv        = 1e-5f;    // UVs Closer Than This are the Same
+    static const float       kNormal    = 0.9999f;  // Normals Within About a Degree are the Same
+    static const float       kCollinear = 1e-12f;   // Squared Sine Below Which a Triangle is Flat
+    static const std::size_t kGrain     = 4096;     // Fewest Items Worth Handing to a Thread
+
+    // Interior Angle at Corner a of Triangle abc
+    static float angle(glm::vec3 const & a, glm::vec3 const & b, glm::vec3 const & c)
+    {
+        glm::vec3 u = b - a, v = c - a;
+        float lengths = std::sqrt(glm::dot(u, u) * glm::dot(v, v));
+        if (lengths <= 0.0f) return 0.0f;
+        return std::acos(std::min(std::max(glm::dot(u, v) / lengths, -1.0f), 1.0f));
+    }
+
+    Geometry::Geometry(unsigned int threads)
+        : mNext(0)
+        , mGeneration(0)
+        , mBusy(0)
+        , mQuit(false)
+        , mBody(nullptr)
+        , mCount(0)
+        , mRanges(0)
+        , mThreads(threads > 0 ? threads : 1)
+    {
+        // The Calling Thread Also Works, so Spawn One Fewer
+        for (unsigned int i = 1; i < mThreads; i++)
+            mWorkers.push_back(std::thread(& Geometry::work, this));
+    }
+
+    Geometry::~Geometry()
+    {
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }   mStart.notify_all();
+        for (auto & thread : mWorkers) thread.join();
+    }
+
+    // Split [0, count) into One Contiguous Range per Thread and Hand Them to the Pool
+    void Geometry::parallel(std::size_t count, std::function<void(std::size_t, std::size_t)> const & body) const
+    {
+        std::size_t ranges = std::min<std::size_t>(mThreads, (count + kGrain - 1) / kGrain);
+        if (ranges <= 1) { body(std::size_t(0), count); return; }
+
+        std::lock_guard<std::mutex> serial(mSerial);
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            mBody   = & body;
+            mCount  = count;
+            mRanges = ranges;
+            mNext   = 0;
+            mBusy   = mWorkers.size();
+            mGeneration++;
+        }   mStart.notify_all();
+
+        drain();
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mBusy == 0; });
+    }
+
+    void Geometry::work()
+    {
+        std::size_t seen = 0;
+        for (;;)
+        {
+            {   std::unique_lock<std::mutex> lock(mMutex);
+                mStart.wait(lock, [&] { return mQuit || mGeneration != seen; });
+                if (mQuit) return;
+                seen = mGeneration;
+            }
+
+            drain();
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mBusy == 0) mDone.notify_one();
+        }
+    }
+
+    void Geometry::drain() const
+    {
+        // Whoever Comes First Takes the Next Range, so a Late Worker Never Holds Up a Loop
+        std::size_t chunk = (mCount + mRanges - 1) / mRanges;
+        for (std::size_t range = mNext.fetch_add(1); range < mRanges; range = mNext.fetch_add(1))
+            (*mBody)(std::min(mCount, range * chunk), std::min(mCount, (range + 1) * chunk));
+    }
+
+    GeometryStats Geometry::process(std::vector<Vertex> & vertices, std::vector<GLuint> & indices,
+                                    GeometryOptions const & options, std::vector<GLuint> * remap) const
+    {
+        // Welding Runs First so the Later Passes See Shared Corners
+        GeometryStats stats = {};
+        if (remap)
+        {   remap->resize(vertices.size());
+            for (std::size_t i = 0; i < remap->size(); i++) (*remap)[i] = static_cast<GLuint>(i);
+        }
+        if (options.weld >= 0.0f)
+            stats.welded = weld(vertices, indices, options.weld, !options.normals, remap);
+        if (options.degenerates) stats.degenerate = degenerates(vertices, indices);
+        if (options.normals) normals(vertices, indices, std::max(options.weld, 0.0f));
+        if (options.tangents) tangents(vertices, indices);
+        return stats;
+    }
+
+    void Geometry::cluster(std::vector<Vertex> const & vertices, float epsilon, bool attributes,
+                           bool normals, std::vector<GLuint> & representatives) const
+    {
+        // Buckets Twice epsilon Wide, so a Match Lies in this Bucket or the Nearer
+        // Neighbour Along Each Axis; Exact Matching Buckets by Bit Pattern Instead
+        struct Cell { std::int64_t x, y, z; int toward; };
+        std::size_t count = vertices.size();
+        std::vector<Cell> cells(count);
+        float size = 2.0f * epsilon;
+        parallel(count, [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t i = begin; i < end; i++)
+            {
+                glm::vec3 p = vertices[i].position + glm::vec3(0.0f); // Fold -0 into +0
+                auto & cell = cells[i];
+                if (epsilon > 0.0f)
+                {   glm::vec3 q = p / size, f(std::floor(q.x), std::floor(q.y), std::floor(q.z));
+                    cell.x = static_cast<std::int64_t>(f.x);
+                    cell.y = static_cast<std::int64_t>(f.y);
+                    cell.z = static_cast<std::int64_t>(f.z);
+                    cell.toward = (q.x - f.x >= 0.5f) | (q.y - f.y >= 0.5f) << 1 | (q.z - f.z >= 0.5f) << 2;
+                }
+                else
+                {   std::uint32_t bits[3]; std::memcpy(bits, & p, sizeof(bits));
+                    cell.x = bits[0]; cell.y = bits[1]; cell.z = bits[2];
+                    cell.toward = 0;
+                }
+            }
+        });
+
+        auto hash = [](std::int64_t x, std::int64_t y, std::int64_t z)
+        {   return static_cast<std::uint64_t>(x) * 73856093ull
+                 ^ static_cast<std::uint64_t>(y) * 19349663ull
+                 ^ static_cast<std::uint64_t>(z) * 83492791ull;
+        };
+        auto same = [&](Vertex const & a, Vertex const & b)
+        {   glm::vec3 d = a.position - b.position;
+            if (std::abs(d.x) > epsilon || std::abs(d.y) > epsilon || std::abs(d.z) > epsilon) return false;
+            if (!attributes) return true;
+            if (std::abs(a.uv.x - b.uv.x) > kUv || std::abs(a.uv.y - b.uv.y) > kUv) return false;
+            return !normals || glm::dot(a.normal, b.normal)
+                >= kNormal * glm::length(a.normal) * glm::length(b.normal);
+        };
+
+        // Chain Representatives per Bucket; Hash Collisions Only Cost Extra Comparisons
+        std::unordered_map<std::uint64_t, GLuint> heads(count);
+        std::vector<GLuint> next(count, kNone);
+        representatives.resize(count);
+        int neighbours = epsilon > 0.0f ? 8 : 1;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            auto & cell = cells[i];
+            GLuint match = kNone;
+            for (int k = 0; k < neighbours && match == kNone; k++)
+            {
+                std::int64_t dx = (k & 1) ? ((cell.toward & 1) ? 1 : -1) : 0;
+                std::int64_t dy = (k & 2) ? ((cell.toward & 2) ? 1 : -1) : 0;
+                std::int64_t dz = (k & 4) ? ((cell.toward & 4) ? 1 : -1) : 0;
+                auto found = heads.find(hash(cell.x + dx, cell.y + dy, cell.z + dz));
+                if (found == heads.end()) continue;
+                for (GLuint j = found->second; j != kNone; j = next[j])
+                    if (same(vertices[i], vertices[j])) { match = j; break; }
+            }
+            if (match != kNone) { representatives[i] = match; continue; }
+            representatives[i] = static_cast<GLuint>(i);
+            auto & head = heads.emplace(hash(cell.x, cell.y, cell.z), kNone).first->second;
+            next[i] = head;
+            head = static_cast<GLuint>(i);
+        }
+    }
+
+    void Geometry::adjacency(std::vector<GLuint> const & keys, std::size_t count,
+                             std::vector<GLuint> & offsets, std::vector<GLuint> & corners) const
+    {
+        // Counting Sort of Corners by Key: Key k Owns corners[offsets[k], offsets[k + 1])
+        offsets.assign(count + 1, 0);
+        for (auto key : keys) offsets[key + 1]++;
+        for (std::size_t i = 0; i < count; i++) offsets[i + 1] += offsets[i];
+        std::vector<GLuint> cursor(offsets.begin(), offsets.end() - 1);
+        corners.resize(keys.size());
+        for (std::size_t c = 0; c < keys.size(); c++) corners[cursor[keys[c]]++] = static_cast<GLuint>(c);
+    }
+
+    std::size_t Geometry::weld(std::vector<Vertex> & vertices, std::vector<GLuint> & indices,
+                               float epsilon, bool normals, std::vector<GLuint> * remap) const
+    {
+        std::vector<GLuint> representatives;
+        cluster(vertices, epsilon, true, normals, representatives);
+
+        // Representatives Always Come First, so Compacting in Place is Safe
+        std::size_t count = vertices.size();
+        std::vector<GLuint> index(count);
+        GLuint kept = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {   if (representatives[i] != i) { index[i] = index[representatives[i]]; continue; }
+            index[i] = kept;
+            vertices[kept++] = vertices[i];
+        }
+        vertices.resize(kept);
+        parallel(indices.size(), [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t i = begin; i < end; i++) indices[i] = index[indices[i]];
+        });
+        if (remap) for (auto & entry : *remap) entry = index[entry];
+        return count - kept;
+    }
+
+    std::size_t Geometry::degenerates(std::vector<Vertex> const & vertices, std::vector<GLuint> & indices) const
+    {
+        std::size_t triangles = indices.size() / 3;
+        std::vector<unsigned char> keep(triangles);
+        parallel(triangles, [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t t = begin; t < end; t++)
+            {
+                GLuint a = indices[3 * t], b = indices[3 * t + 1], c = indices[3 * t + 2];
+                if (a == b || b == c || c == a) { keep[t] = 0; continue; }
+
+                // Compare the Area Against the Longest Edge, so Scale Does Not Matter
+                glm::vec3 u = vertices[b].position - vertices[a].position;
+                glm::vec3 v = vertices[c].position - vertices[a].position;
+                glm::vec3 w = vertices[c].position - vertices[b].position;
+                glm::vec3 n = glm::cross(u, v);
+                float longest = std::max(std::max(glm::dot(u, u), glm::dot(v, v)), glm::dot(w, w));
+                keep[t] = glm::dot(n, n) > kCollinear * longest * longest;
+            }
+        });
+
+        std::size_t kept = 0;
+        for (std::size_t t = 0; t < triangles; t++)
+        {   if (!keep[t]) continue;
+            for (int k = 0; k < 3; k++) indices[3 * kept + k] = indices[3 * t + k];
+            kept++;
+        }
+        indices.resize(3 * kept);
+        return triangles - kept;
+    }
+
+    void Geometry::normals(std::vector<Vertex> & vertices, std::vector<GLuint> const & indices,
+                           float epsilon) const
+    {
+        // Unit Face Normal Times the Interior Angle at Every Corner
+        std::vector<glm::vec3> weighted(indices.size());
+        parallel(indices.size() / 3, [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t t = begin; t < end; t++)
+            {
+                glm::vec3 const & a = vertices[indices[3 * t]].position;
+                glm::vec3 const & b = vertices[indices[3 * t + 1]].position;
+                glm::vec3 const & c = vertices[indices[3 * t + 2]].position;
+                glm::vec3 n = glm::cross(b - a, c - a);
+                float length = glm::length(n);
+                if (length > 0.0f) n /= length;
+                weighted[3 * t]     = n * angle(a, b, c);
+                weighted[3 * t + 1] = n * angle(b, c, a);
+                weighted[3 * t + 2] = n * angle(c, a, b);
+            }
+        });
+
+        // Each Position Group is Summed by One Thread, so No Two Threads Share an Output
+        std::vector<GLuint> groups, keys(indices.size()), offsets, corners;
+        cluster(vertices, epsilon, false, false, groups);
+        parallel(indices.size(), [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t c = begin; c < end; c++) keys[c] = groups[indices[c]];
+        });
+        adjacency(keys, vertices.size(), offsets, corners);
+        std::vector<glm::vec3> sums(vertices.size());
+        parallel(vertices.size(), [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t g = begin; g < end; g++)
+            {
+                if (groups[g] != g) continue;
+                glm::vec3 sum(0.0f);
+                for (GLuint i = offsets[g]; i < offsets[g + 1]; i++) sum += weighted[corners[i]];
+                float length = glm::length(sum);
+                sums[g] = length > 0.0f ? sum / length : vertices[g].normal;
+            }
+        });
+        parallel(vertices.size(), [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t v = begin; v < end; v++) vertices[v].normal = sums[groups[v]];
+        });
+    }
+
+    void Geometry::tangents(std::vector<Vertex> & vertices, std::vector<GLuint> const & indices) const
+    {
+        // Face Tangent Frames from UV Gradients, Projected per Corner onto the Vertex Normal
+        std::vector<glm::vec3> tangent(indices.size()), bitangent(indices.size());
+        std::vector<float> orientation(indices.size());
+        parallel(indices.size() / 3, [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t t = begin; t < end; t++)
+            {
+                Vertex const * corner[3] = { & vertices[indices[3 * t]], & vertices[indices[3 * t + 1]],
+                                             & vertices[indices[3 * t + 2]] };
+                glm::vec3 e1 = corner[1]->position - corner[0]->position, e2 = corner[2]->position - corner[0]->position;
+                glm::vec2 d1 = corner[1]->uv - corner[0]->uv, d2 = corner[2]->uv - corner[0]->uv;
+                float area = d1.x * d2.y - d2.x * d1.y;
+                for (int k = 0; k < 3; k++) orientation[3 * t + k] = 0.0f;
+                if (std::abs(area) <= std::numeric_limits<float>::min()) continue;
+                glm::vec3 faceTangent   = (e1 * d2.y - e2 * d1.y) / area;
+                glm::vec3 faceBitangent = (e2 * d1.x - e1 * d2.x) / area;
+                for (int k = 0; k < 3; k++)
+                {
+                    glm::vec3 const & n = corner[k]->normal;
+                    glm::vec3 u = faceTangent - n * glm::dot(n, faceTangent);
+                    glm::vec3 v = faceBitangent - n * glm::dot(n, faceBitangent);
+                    float weight = angle(corner[k]->position, corner[(k + 1) % 3]->position, corner[(k + 2) % 3]->position);
+                    float lu = glm::length(u), lv = glm::length(v);
+                    tangent[3 * t + k]     = lu > 0.0f ? u * (weight / lu) : glm::vec3(0.0f);
+                    bitangent[3 * t + k]   = lv > 0.0f ? v * (weight / lv) : glm::vec3(0.0f);
+                    orientation[3 * t + k] = area > 0.0f ? 1.0f : -1.0f;
+                }
+            }
+        });
+
+        // Mirrored UV Islands Meeting at a Vertex Would Cancel Out; Keep the Heavier Side
+        std::vector<GLuint> offsets, corners;
+        adjacency(indices, vertices.size(), offsets, corners);
+        parallel(vertices.size(), [&](std::size_t begin, std::size_t end)
+        {   for (std::size_t v = begin; v < end; v++)
+            {
+                glm::vec3 t[2] = { glm::vec3(0.0f), glm::vec3(0.0f) }, b[2] = { glm::vec3(0.0f), glm::vec3(0.0f) };
+                float weight[2] = { 0.0f, 0.0f };
+                for (GLuint i = offsets[v]; i < offsets[v + 1]; i++)
+                {   GLuint c = corners[i];
+                    if (orientation[c] == 0.0f) continue;
+                    int side = orientation[c] > 0.0f ? 0 : 1;
+                    t[side] += tangent[c];
+                    b[side] += bitangent[c];
+                    weight[side] += glm::length(tangent[c]);
+                }
+                int side = weight[0] >= weight[1] ? 0 : 1;
+
+                // Gram-Schmidt Against the Normal, Falling Back to Any Perpendicular
+                glm::vec3 const & n = vertices[v].normal;
+                glm::vec3 u = t[side] - n * glm::dot(n, t[side]);
+                if (glm::length(u) <= 1e-12f)
+                {   glm::vec3 axis = std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                    u = axis - n * glm::dot(n, axis);
+                }
+                u = glm::normalize(u);
+                float sign = glm::dot(glm::cross(n, u), b[side]) < 0.0f ? -1.0f : 1.0f;
+                vertices[v].tangent = glm::vec4(u.x, u.y, u.z, sign);
+            }
+        });
+    }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+// Local Headers
+#include "mesh.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Passes Run by Geometry::process, in This Order
+    struct GeometryOptions {
+        float weld;         // Merge Vertices Closer Than This; Zero Merges Exact Copies, Negative Skips
+        bool  degenerates;  // Drop Triangles with Repeated Corners or No Area
+        bool  normals;      // Replace Normals with Angle-Weighted Smooth Normals
+        bool  tangents;     // Generate Tangents with Handedness in w; Needs UVs
+    };
+
+    // What the Last Call to process Changed
+    struct GeometryStats {
+        std::size_t welded;     // Vertices Merged into Others
+        std::size_t degenerate; // Triangles Removed
+    };
+
+    class Geometry
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor; Workers Live as Long as the Geometry,
+        // so Reuse One Instance Rather Than Creating One per Mesh
+         Geometry(unsigned int threads = std::thread::hardware_concurrency());
+        ~Geometry();
+
+        // Run the Enabled Passes over Indexed Triangles. When remap is Given, it Receives
+        // the New Index of Every Original Vertex, e.g. to Carry Bone Weights Across
+        GeometryStats process(std::vector<Vertex> & vertices, std::vector<GLuint> & indices,
+                              GeometryOptions const & options, std::vector<GLuint> * remap = nullptr) const;
+
+        // Merge Vertices Whose Positions and UVs, and Normals When Asked, Match
+        std::size_t weld(std::vector<Vertex> & vertices, std::vector<GLuint> & indices,
+                         float epsilon, bool normals, std::vector<GLuint> * remap = nullptr) const;
+
+        // Remove Triangles with Repeated Corners or Collinear Positions
+        std::size_t degenerates(std::vector<Vertex> const & vertices, std::vector<GLuint> & indices) const;
+
+        // Average Face Normals Weighted by Corner Angle. Vertices Sharing a Position Share
+        // a Normal, so UV Seams Do Not Show in the Shading
+        void normals(std::vector<Vertex> & vertices, std::vector<GLuint> const & indices, float epsilon) const;
+
+        // MikkTSpace Conventions: Face Tangents are Projected onto Each Vertex's Normal Plane
+        // and Weighted by Corner Angle, and Bitangents are Rebuilt as w * cross(normal, tangent)
+        void tangents(std::vector<Vertex> & vertices, std::vector<GLuint> const & indices) const;
+
+    private:
+
+        // Disable Copying and Assignment
+        Geometry(Geometry const &) = delete;
+        Geometry & operator=(Geometry const &) = delete;
+
+        // Private Member Functions
+        void parallel(std::size_t count, std::function<void(std::size_t, std::size_t)> const & body) const;
+        void work();
+        void drain() const;
+        void cluster(std::vector<Vertex> const & vertices, float epsilon, bool attributes,
+                     bool normals, std::vector<GLuint> & representatives) const;
+        void adjacency(std::vector<GLuint> const & keys, std::size_t count,
+                       std::vector<GLuint> & offsets, std::vector<GLuint> & corners) const;
+
+        // Worker Threads and Their Hand-Off State; Passes are Const, so Loops Running on
+        // Different Threads Take Turns Through mSerial
+        std::vector<std::thread> mWorkers;
+        mutable std::mutex mSerial;
+        mutable std::mutex mMutex;
+        mutable std::condition_variable mStart;
+        mutable std::condition_variable mDone;
+        mutable std::atomic<std::size_t> mNext;
+        mutable std::size_t mGeneration;
+        mutable std::size_t mBusy;
+        bool mQuit;
+
+        // The Loop Currently Being Run
+        mutable std::function<void(std::size_t, std::size_t)> const * mBody;
+        mutable std::size_t mCount;
+        mutable std::size_t mRanges;
+
+        // Private Member Variables
+        unsigned int mThreads;
+
+    };
+};
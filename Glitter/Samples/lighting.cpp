@@ -0,0 +1,174 @@
+// Local Headers
+#include "lighting.hpp"
+
+// Preprocessor Directives
+#if defined(__SSE2__) || defined(_M_X64)
+#define MIRAGE_SSE
+#include <emmintrin.h>
+#endif
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Define Namespace
+namespace Mirage
+{
+    Lighting::Lighting(int tilesX, int tilesY, int slices)
+        : mMin(tilesX * tilesY * slices)
+        , mMax(tilesX * tilesY * slices)
+        , mClusters(tilesX * tilesY * slices)
+        , mTilesX(tilesX), mTilesY(tilesY), mSlices(slices)
+        , mWidth(1), mHeight(1)
+        , mNear(0.1f), mFar(100.0f)
+        , mBuffers()
+    {}
+
+    Lighting::~Lighting()
+    {
+        if (mBuffers[0]) glDeleteBuffers(3, mBuffers);
+    }
+
+    void Lighting::resize(glm::mat4 const & projection, float near, float far,
+                          int width, int height)
+    {
+        mNear = near; mFar = far;
+        mWidth = width; mHeight = height;
+
+        // Unproject a Pixel to a Point at the Given View Depth
+        glm::mat4 inverse = glm::inverse(projection);
+        auto unproject = [&](float x, float y, float depth)
+        {   glm::vec4 point = inverse * glm::vec4(2.0f * x / width - 1.0f,
+                                                  2.0f * y / height - 1.0f, -1.0f, 1.0f);
+            glm::vec3 ray = glm::vec3(point) / point.w;
+            return ray * (depth / -ray.z);
+        };
+
+        // Exponential Slices Keep Clusters Roughly Cubic Along the View Direction
+        float tileX = std::ceil(static_cast<float>(width)  / mTilesX);
+        float tileY = std::ceil(static_cast<float>(height) / mTilesY);
+        for (int z = 0; z < mSlices; z++)
+        for (int y = 0; y < mTilesY; y++)
+        for (int x = 0; x < mTilesX; x++)
+        {
+            float front = near * std::pow(far / near, static_cast<float>(z)     / mSlices);
+            float back  = near * std::pow(far / near, static_cast<float>(z + 1) / mSlices);
+            glm::vec3 lo( std::numeric_limits<float>::max());
+            glm::vec3 hi(-std::numeric_limits<float>::max());
+            for (int i = 0; i < 8; i++)
+            {
+                glm::vec3 corner = unproject((x + (i & 1)) * tileX,
+                                             (y + ((i >> 1) & 1)) * tileY,
+                                             i & 4 ? back : front);
+                lo = glm::min(lo, corner);
+                hi = glm::max(hi, corner);
+            }
+            mMin[cluster(x, y, z)] = lo;
+            mMax[cluster(x, y, z)] = hi;
+        }
+    }
+
+    void Lighting::assign(std::vector<Light> const & lights, glm::mat4 const & view)
+    {
+        // Move Lights to View Space and Bucket Them by the Slices They Touch
+        mLights.resize(lights.size());
+        std::vector<std::vector<GLuint>> buckets(mSlices);
+        for (std::size_t i = 0; i < lights.size(); i++)
+        {
+            mLights[i] = lights[i];
+            mLights[i].position = glm::vec3(view * glm::vec4(lights[i].position, 1.0f));
+            float depth = -mLights[i].position.z, radius = lights[i].radius;
+            if (depth + radius < mNear || depth - radius > mFar) continue;
+            for (int z = slice(depth - radius); z <= slice(depth + radius); z++)
+                buckets[z].push_back(i);
+        }
+
+        // Test Every Cluster Only Against the Lights in its Slice
+        mIndices.clear();
+        for (int z = 0; z < mSlices; z++)
+        {
+            auto & candidates = buckets[z];
+            std::size_t padded = (candidates.size() + 3) & ~std::size_t(3);
+            mX.assign(padded, 0.0f); mY.assign(padded, 0.0f);
+            mZ.assign(padded, 1e30f); mRadius.assign(padded, 0.0f);
+            for (std::size_t i = 0; i < candidates.size(); i++)
+            {
+                auto & light = mLights[candidates[i]];
+                mX[i] = light.position.x;
+                mY[i] = light.position.y;
+                mZ[i] = light.position.z;
+                mRadius[i] = light.radius;
+            }
+            for (int y = 0; y < mTilesY; y++)
+            for (int x = 0; x < mTilesX; x++)
+                gather(cluster(x, y, z), candidates);
+        }
+    }
+
+    void Lighting::gather(int cluster, std::vector<GLuint> const & candidates)
+    {
+        // Sphere Versus Box: Squared Distance from Center to the Box
+        auto & lo = mMin[cluster]; auto & hi = mMax[cluster];
+        mClusters[cluster].offset = mIndices.size();
+        std::size_t i = 0;
+#ifdef MIRAGE_SSE
+        __m128 zero = _mm_setzero_ps();
+        __m128 loX = _mm_set1_ps(lo.x), loY = _mm_set1_ps(lo.y), loZ = _mm_set1_ps(lo.z);
+        __m128 hiX = _mm_set1_ps(hi.x), hiY = _mm_set1_ps(hi.y), hiZ = _mm_set1_ps(hi.z);
+        for (; i + 4 <= mX.size(); i += 4)
+        {
+            __m128 x = _mm_loadu_ps(& mX[i]), y = _mm_loadu_ps(& mY[i]);
+            __m128 z = _mm_loadu_ps(& mZ[i]), r = _mm_loadu_ps(& mRadius[i]);
+            __m128 dx = _mm_add_ps(_mm_max_ps(_mm_sub_ps(loX, x), zero), _mm_max_ps(_mm_sub_ps(x, hiX), zero));
+            __m128 dy = _mm_add_ps(_mm_max_ps(_mm_sub_ps(loY, y), zero), _mm_max_ps(_mm_sub_ps(y, hiY), zero));
+            __m128 dz = _mm_add_ps(_mm_max_ps(_mm_sub_ps(loZ, z), zero), _mm_max_ps(_mm_sub_ps(z, hiZ), zero));
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            int mask = _mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(r, r)));
+            for (int lane = 0; mask; lane++, mask >>= 1)
+                if (mask & 1) mIndices.push_back(candidates[i + lane]);
+        }
+#endif
+        for (; i < candidates.size(); i++)
+        {
+            float dx = std::max(lo.x - mX[i], 0.0f) + std::max(mX[i] - hi.x, 0.0f);
+            float dy = std::max(lo.y - mY[i], 0.0f) + std::max(mY[i] - hi.y, 0.0f);
+            float dz = std::max(lo.z - mZ[i], 0.0f) + std::max(mZ[i] - hi.z, 0.0f);
+            if (dx * dx + dy * dy + dz * dz <= mRadius[i] * mRadius[i])
+                mIndices.push_back(candidates[i]);
+        }
+        mClusters[cluster].count = mIndices.size() - mClusters[cluster].offset;
+    }
+
+    void Lighting::bind(GLuint shader)
+    {
+        // Orphan and Refill the Storage Buffers Every Frame
+        if (!mBuffers[0]) glGenBuffers(3, mBuffers);
+        auto upload = [](GLuint buffer, GLuint binding, GLsizeiptr size, void const * data)
+        {   glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<GLsizeiptr>(size, 16), nullptr, GL_STREAM_DRAW);
+            if (size > 0) glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, data);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+        };
+        upload(mBuffers[0], 0, mLights.size()   * sizeof(Light),   mLights.data());
+        upload(mBuffers[1], 1, mClusters.size() * sizeof(Cluster), mClusters.data());
+        upload(mBuffers[2], 2, mIndices.size()  * sizeof(GLuint),  mIndices.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        // Let the Fragment Shader Recompute its Cluster from gl_FragCoord
+        float scale = mSlices / std::log(mFar / mNear);
+        glUniform3ui(glGetUniformLocation(shader, "clusterGrid"), mTilesX, mTilesY, mSlices);
+        glUniform2f(glGetUniformLocation(shader, "tileSize"),
+                    std::ceil(static_cast<float>(mWidth)  / mTilesX),
+                    std::ceil(static_cast<float>(mHeight) / mTilesY));
+        glUniform1f(glGetUniformLocation(shader, "sliceScale"), scale);
+        glUniform1f(glGetUniformLocation(shader, "sliceBias"), -scale * std::log(mNear));
+    }
+
+    int Lighting::slice(float depth) const
+    {
+        if (depth <= mNear) return 0;
+        int z = static_cast<int>(std::floor(std::log(depth / mNear) * mSlices / std::log(mFar / mNear)));
+        return std::min(mSlices - 1, std::max(0, z));
+    }
+};
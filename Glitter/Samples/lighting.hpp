@@ -0,0 +1,81 @@
+#pragma once
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Point Light Format, Matches the std430 Layout in clustered.frag
+    struct Light {
+        glm::vec3 position;
+        float     radius;
+        glm::vec3 color;
+        float     intensity;
+        GLuint    shadow;       // One Plus the First of Six Shadows::point Views; Zero Casts None
+        GLuint    padding[3];
+    };
+
+    // Cluster Format: A Range of the Light Index List
+    struct Cluster {
+        GLuint offset;
+        GLuint count;
+    };
+
+    class Lighting
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Lighting(int tilesX = 16, int tilesY = 9, int slices = 24);
+        ~Lighting();
+
+        // Rebuild Cluster Bounds Whenever the Projection Changes
+        void resize(glm::mat4 const & projection, float near, float far,
+                    int width, int height);
+
+        // Assign World-Space Lights to Clusters on the CPU
+        void assign(std::vector<Light> const & lights, glm::mat4 const & view);
+
+        // Upload Cluster Data and Bind it for clustered.frag
+        void bind(GLuint shader);
+
+        // Public Accessors
+        std::vector<Cluster> const & clusters() const { return mClusters; }
+        std::vector<GLuint>  const & indices()  const { return mIndices; }
+        int cluster(int x, int y, int z) const { return (z * mTilesY + y) * mTilesX + x; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Lighting(Lighting const &) = delete;
+        Lighting & operator=(Lighting const &) = delete;
+
+        // Private Member Functions
+        int slice(float depth) const;
+        void gather(int cluster, std::vector<GLuint> const & candidates);
+
+        // View-Space Cluster Bounds
+        std::vector<glm::vec3> mMin;
+        std::vector<glm::vec3> mMax;
+
+        // Lights in View Space, Stored as Padded Structure of Arrays for SIMD
+        std::vector<float> mX, mY, mZ, mRadius;
+        std::vector<Light> mLights;
+
+        // Private Member Containers
+        std::vector<Cluster> mClusters;
+        std::vector<GLuint>  mIndices;
+
+        // Private Member Variables
+        int   mTilesX, mTilesY, mSlices;
+        int   mWidth, mHeight;
+        float mNear, mFar;
+        GLuint mBuffers[3];
+
+    };
+};
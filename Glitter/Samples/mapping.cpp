@@ -0,0 +1,72 @@
+// Local Headers
+#include "mapping.hpp"
+
+// System Headers
+#ifdef _WIN32
+#define NOMINMAX
+#include <direct.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Define Namespace
+namespace Mirage
+{
+    void * mapFile(std::string const & path, std::size_t & length, bool random)
+    {
+        void * address = nullptr;
+        length = 0;
+#ifdef _WIN32
+        (void) random;
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER size; GetFileSizeEx(file, & size);
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (mapping) CloseHandle(mapping);
+            if (address) length = static_cast<std::size_t>(size.QuadPart);
+            CloseHandle(file);
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd != -1 && fstat(fd, & info) == 0 && info.st_size > 0)
+        {
+            address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED) address = nullptr;
+            else
+            {   length = static_cast<std::size_t>(info.st_size);
+                madvise(address, length, random ? MADV_RANDOM : MADV_WILLNEED);
+            }
+        }
+        if (fd != -1) close(fd);
+#endif
+        return address;
+    }
+
+    void unmapFile(void * address, std::size_t length)
+    {
+        if (!address) return;
+#ifdef _WIN32
+        (void) length;
+        UnmapViewOfFile(address);
+#else
+        munmap(address, length);
+#endif
+    }
+
+    void makeDirectory(std::string const & path)
+    {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+};
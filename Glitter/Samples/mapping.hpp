@@ -0,0 +1,17 @@
+#pragma once
+
+// Standard Headers
+#include <cstddef>
+#include <string>
+
+// Define Namespace
+namespace Mirage
+{
+    // Map a Whole File Read-Only so Pages are Shared Between Processes. Returns nullptr
+    // and Leaves length at Zero on Failure; random Hints Pages are Touched Out of Order
+    void * mapFile(std::string const & path, std::size_t & length, bool random = false);
+    void unmapFile(void * address, std::size_t length);
+
+    // Create a Single Directory if it Does Not Exist Yet; Its Parent Must Exist
+    void makeDirectory(std::string const & path);
+};
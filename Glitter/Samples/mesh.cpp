@@ -3,27 +3,123 @@
 
 // Local Headers
 #include "mesh.hpp"
+#include "geometry.hpp"
 
 // System Headers
 #include <stb_image.h>
 
+// Standard Headers
+#include <algorithm>
+#include <cstring>
+
 // Define Namespace
 namespace Mirage
 {
     Mesh::Mesh(std::string const & filename) : Mesh()
     {
-        // Load a Model from File
+        load(filename, nullptr, -1);
+    }
+
+    Mesh::Mesh(std::string const & filename, Scene & scene, int parent) : Mesh()
+    {
+        load(filename, & scene, parent);
+    }
+
+    void Mesh::load(std::string const & filename, Scene * graph, int parent)
+    {
+        // Load a Model from File; Keep the Node Tree if it Goes into a Scene
         Assimp::Importer loader;
         aiScene const * scene = loader.ReadFile(
             PROJECT_SOURCE_DIR "/Mirage/Models/" + filename,
-            aiProcessPreset_TargetRealtime_MaxQuality |
-            aiProcess_OptimizeGraph                   |
-            aiProcess_FlipUVs);
+            kImport | (graph ? 0 : aiProcess_OptimizeGraph));
 
         // Walk the Tree of Scene Nodes
         auto index = filename.find_last_of("/");
-        if (!scene) fprintf(stderr, "%s\n", loader.GetErrorString());
-        else parse(filename.substr(0, index), scene->mRootNode, scene);
+        if (!scene) { fprintf(stderr, "%s\n", loader.GetErrorString()); return; }
+        bool rigged = scene->mNumAnimations > 0;
+        for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+            rigged |= scene->mMeshes[i]->mNumBones > 0;
+        if (rigged) mSkeleton.reset(new Skeleton(scene));
+        parse(filename.substr(0, index), scene->mRootNode, scene, graph, parent);
+
+        // Resample Animations Against the Skeleton
+        for (unsigned int i = 0; i < scene->mNumAnimations; i++)
+            mClips.push_back(Clip(*mSkeleton, scene->mAnimations[i]));
+    }
+
+    Mesh::~Mesh()
+    {
+        glDeleteVertexArrays(1, & mVertexArray);
+        glDeleteVertexArrays(1, & mDepthArray);
+        if (!mOwned.empty()) glDeleteTextures(mOwned.size(), mOwned.data());
+        if (mInfluences.empty()) return;
+        glDeleteBuffers(1, & mVertexBuffer);
+        glDeleteBuffers(1, & mPositionBuffer);
+    }
+
+    Mesh::Mesh(Bundle const & bundle, std::string const & filename) : Mesh()
+    {
+        // Find the Packed Model in the Table of Contents
+        auto entry = bundle.find(filename);
+        if (!entry || entry->type != BundleMesh)
+        {   fprintf(stderr, "%s %s\n", "Missing Bundle Entry", filename.c_str());
+            return;
+        }
+
+        // Walk the Sub-Mesh Records, Uploading Straight from the Mapped Pages. Every
+        // Advance is Checked Against the Entry, so a Corrupt Bundle Cannot Read Past it
+        std::map<std::string, GLuint> cache;
+        auto cursor = static_cast<char const *>(bundle.data(*entry));
+        std::uint64_t remaining = entry->size;
+        auto take = [&](std::uint64_t count, std::uint64_t size) -> char const *
+        {   if (count > remaining / size) return nullptr;
+            auto block = cursor;
+            cursor    += count * size;
+            remaining -= count * size;
+            return block;
+        };
+        for (unsigned int i = 0; i < entry->count; i++)
+        {
+            auto record     = reinterpret_cast<BundleRecord const *>(take(1, sizeof(BundleRecord)));
+            auto vertices   = record ? reinterpret_cast<Vertex const *>(take(record->vertices, sizeof(Vertex))) : nullptr;
+            auto indices    = vertices ? reinterpret_cast<GLuint const *>(take(record->indices, sizeof(GLuint))) : nullptr;
+            auto references = indices ? reinterpret_cast<BundleReference const *>(take(record->textures, sizeof(BundleReference))) : nullptr;
+            if (!references)
+            {   fprintf(stderr, "%s %s\n", "Truncated Bundle Entry", filename.c_str());
+                return;
+            }
+
+            // Upload Each Referenced Texture Once per Model
+            std::map<GLuint, std::string> textures;
+            for (unsigned int j = 0; j < record->textures; j++)
+            {
+                std::string name(references[j].name, strnlen(references[j].name, sizeof(references[j].name)));
+                if (cache.find(name) == cache.end())
+                {
+                    auto texture = bundle.find(name);
+                    if (!texture || texture->type != BundleTexture)
+                    {   fprintf(stderr, "%s %s\n", "Missing Bundle Entry", name.c_str());
+                        continue;
+                    }
+                    auto image = static_cast<BundleImage const *>(bundle.data(*texture));
+                    if (texture->size < sizeof(BundleImage) || image->channels < 1 || image->channels > 4
+                        || (texture->size - sizeof(BundleImage)) / image->channels
+                           / std::max<std::uint64_t>(image->width, 1) < image->height)
+                    {   fprintf(stderr, "%s %s\n", "Truncated Bundle Entry", name.c_str());
+                        continue;
+                    }
+                    cache[name] = upload(reinterpret_cast<unsigned char const *>(image + 1),
+                                         image->width, image->height, image->channels);
+                    mOwned.push_back(cache[name]);
+                    mTextureBytes += std::size_t(image->width) * image->height * 16 / 3;
+                }
+                textures.insert(std::make_pair(cache[name],
+                                references[j].mode == 0 ? "diffuse" : "specular"));
+            }
+
+            mSubMeshes.push_back(std::unique_ptr<Mesh>(new Mesh(
+                vertices, record->vertices, indices, record->indices, textures)));
+        }
     }
 
     Mesh::Mesh(std::vector<Vertex> const & vertices,
@@ -32,7 +128,37 @@ namespace Mirage
                     : mIndices(indices)
                     , mVertices(vertices)
                     , mTextures(textures)
+                    , mNode(-1)
+                    , mGeometryBytes(0)
+                    , mTextureBytes(0)
     {
+        upload(& mVertices.front(), mVertices.size(),
+               & mIndices.front(),  mIndices.size());
+    }
+
+    Mesh::Mesh(Vertex const * vertices, GLsizei vertexCount,
+               GLuint const * indices,  GLsizei indexCount,
+               std::map<GLuint, std::string> const & textures)
+                    : mTextures(textures)
+                    , mNode(-1)
+                    , mGeometryBytes(0)
+                    , mTextureBytes(0)
+    {
+        upload(vertices, vertexCount, indices, indexCount);
+    }
+
+    void Mesh::upload(Vertex const * vertices, GLsizei vertexCount,
+                      GLuint const * indices,  GLsizei indexCount)
+    {
+        // Compute Bounds for Culling
+        mCount = indexCount;
+        mGeometryBytes = vertexCount * (sizeof(Vertex) + sizeof(glm::vec3)) + indexCount * sizeof(GLuint);
+        mMin = mMax = vertexCount > 0 ? vertices[0].position : glm::vec3(0.0f);
+        for (GLsizei i = 1; i < vertexCount; i++)
+        {   mMin = glm::min(mMin, vertices[i].position);
+            mMax = glm::max(mMax, vertices[i].position);
+        }
+
         // Bind a Vertex Array Object
         glGenVertexArrays(1, & mVertexArray);
         glBindVertexArray(mVertexArray);
@@ -41,129 +167,340 @@ namespace Mirage
         glGenBuffers(1, & mVertexBuffer);
         glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
         glBufferData(GL_ARRAY_BUFFER,
-                     mVertices.size() * sizeof(Vertex),
-                   & mVertices.front(), GL_STATIC_DRAW);
+                     vertexCount * sizeof(Vertex),
+                     vertices, GL_STATIC_DRAW);
 
         // Copy Index Buffer Data
         glGenBuffers(1, & mElementBuffer);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementBuffer);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     mIndices.size() * sizeof(GLuint),
-                   & mIndices.front(), GL_STATIC_DRAW);
+                     indexCount * sizeof(GLuint),
+                     indices, GL_STATIC_DRAW);
 
         // Set Shader Attributes
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, position));
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, normal));
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, uv));
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, tangent));
         glEnableVertexAttribArray(0); // Vertex Positions
         glEnableVertexAttribArray(1); // Vertex Normals
         glEnableVertexAttribArray(2); // Vertex UVs
+        glEnableVertexAttribArray(5); // Vertex Tangents
+
+        // Tightly Packed Position Stream for Depth-Only Passes
+        std::vector<glm::vec3> positions(vertexCount);
+        for (GLsizei i = 0; i < vertexCount; i++) positions[i] = vertices[i].position;
+        glGenVertexArrays(1, & mDepthArray);
+        glBindVertexArray(mDepthArray);
+        glGenBuffers(1, & mPositionBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mPositionBuffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     vertexCount * sizeof(glm::vec3),
+                     positions.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementBuffer);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (GLvoid *) 0);
+        glEnableVertexAttribArray(0); // Vertex Positions
 
         // Cleanup Buffers
         glBindVertexArray(0);
         glDeleteBuffers(1, & mVertexBuffer);
         glDeleteBuffers(1, & mElementBuffer);
+        glDeleteBuffers(1, & mPositionBuffer);
     }
 
     void Mesh::draw(GLuint shader)
     {
-        unsigned int unit = 0, diffuse = 0, specular = 0;
         for (auto &i : mSubMeshes) i->draw(shader);
+        if (mCount > 0) render(shader);
+    }
+
+    void Mesh::draw(GLuint shader, Occlusion & occlusion, glm::mat4 const & model)
+    {
+        for (auto &i : mSubMeshes) i->draw(shader, occlusion, model);
+        if (mCount > 0 && occlusion.visible(mMin, mMax, model)) render(shader);
+    }
+
+    void Mesh::draw(GLuint shader, Scene const & scene, glm::mat4 const & model)
+    {
+        for (auto &i : mSubMeshes) i->draw(shader, scene, model);
+        if (mCount == 0) return;
+
+        // Meshes Outside the Scene, and Shaders Without a Node Index, Use a Model Matrix
+        GLint node = glGetUniformLocation(shader, "node");
+        if (node >= 0) glUniform1i(node, mNode);
+        if (node < 0 || mNode < 0)
+        {   glm::mat4 const & world = mNode >= 0 ? scene.world(mNode) : model;
+            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, & world[0][0]);
+        }
+        render(shader);
+    }
+
+    void Mesh::occlude(Occlusion & occlusion, glm::mat4 const & model)
+    {
+        // Only Meshes that Kept a CPU Copy Can Act as Occluders
+        for (auto &i : mSubMeshes) i->occlude(occlusion, model);
+        if (!mIndices.empty())
+            occlusion.rasterize(& mVertices.front().position, sizeof(Vertex),
+                                & mIndices.front(), mIndices.size(), model);
+    }
+
+    unsigned int Mesh::depth()
+    {
+        unsigned int draws = 0;
+        for (auto &i : mSubMeshes) draws += i->depth();
+        if (mCount == 0) return draws;
+        glBindVertexArray(mDepthArray);
+        glDrawElements(GL_TRIANGLES, mCount, GL_UNSIGNED_INT, 0);
+        return draws + 1;
+    }
+
+    void Mesh::render(GLuint shader)
+    {
+        textures(shader);
+        glBindVertexArray(mVertexArray);
+        glDrawElements(GL_TRIANGLES, mCount, GL_UNSIGNED_INT, 0);
+    }
+
+    void Mesh::textures(GLuint shader) const
+    {
+        unsigned int unit = 0, diffuse = 0, specular = 0;
         for (auto &i : mTextures)
         {   // Set Correct Uniform Names Using Texture Type (Omit ID for 0th Texture)
             std::string uniform = i.second;
                  if (i.second == "diffuse")  uniform += (diffuse++  > 0) ? std::to_string(diffuse)  : "";
             else if (i.second == "specular") uniform += (specular++ > 0) ? std::to_string(specular) : "";
 
-            // Bind Correct Textures and Vertex Array Before Drawing
+            // Bind Correct Textures Before Drawing
             glActiveTexture(GL_TEXTURE0 + unit);
             glBindTexture(GL_TEXTURE_2D, i.first);
-            glUniform1f(glGetUniformLocation(shader, uniform.c_str()), ++unit);
-        }   glBindVertexArray(mVertexArray);
-            glDrawElements(GL_TRIANGLES, mIndices.size(), GL_UNSIGNED_INT, 0);
+            glUniform1i(glGetUniformLocation(shader, uniform.c_str()), unit++);
+        }
     }
 
-    void Mesh::parse(std::string const & path, aiNode const * node, aiScene const * scene)
+    void Mesh::parse(std::string const & path, aiNode const * node, aiScene const * scene,
+                     Scene * graph, int parent)
     {
+        // Mirror the Node into the Scene so its Sub-Meshes Can Move Independently
+        int index = graph ? graph->add(node->mName.C_Str(), parent, convert(node->mTransformation)) : -1;
         for (unsigned int i = 0; i < node->mNumMeshes; i++)
-            parse(path, scene->mMeshes[node->mMeshes[i]], scene);
+        {   parse(path, scene->mMeshes[node->mMeshes[i]], scene);
+            mSubMeshes.back()->mNode = index;
+        }
         for (unsigned int i = 0; i < node->mNumChildren; i++)
-            parse(path, node->mChildren[i], scene);
+            parse(path, node->mChildren[i], scene, graph, index);
     }
 
     void Mesh::parse(std::string const & path, aiMesh const * mesh, aiScene const * scene)
     {
-        // Create Vertex Data from Mesh Node
-        std::vector<Vertex> vertices; Vertex vertex;
+        // Create Vertex Data and Indices from Mesh Node
+        std::vector<Vertex> vertices;
+        std::vector<GLuint> indices, remap;
+        extract(mesh, vertices, indices, & remap);
+
+        // Load Mesh Textures into VRAM
+        std::size_t bytes = 0;
+        std::map<GLuint, std::string> textures;
+        auto diffuse  = process(path, scene->mMaterials[mesh->mMaterialIndex], aiTextureType_DIFFUSE,  bytes);
+        auto specular = process(path, scene->mMaterials[mesh->mMaterialIndex], aiTextureType_SPECULAR, bytes);
+        textures.insert(diffuse.begin(), diffuse.end());
+        textures.insert(specular.begin(), specular.end());
+
+        // Create New Mesh Node, Which Owns the Textures it Loaded
+        mSubMeshes.push_back(std::unique_ptr<Mesh>(new Mesh(vertices, indices, textures)));
+        for (auto & texture : textures) mSubMeshes.back()->mOwned.push_back(texture.first);
+        mSubMeshes.back()->mTextureBytes = bytes;
+        if (!mSkeleton || mesh->mNumBones == 0) return;
+
+        // Gather Weights by Imported Vertex; Welding is Resolved by weigh
+        std::vector<BoneWeight> weights;
+        for (unsigned int i = 0; i < mesh->mNumBones; i++)
+        {
+            aiBone const * bone = mesh->mBones[i];
+            int joint = mSkeleton->find(bone->mName.C_Str());
+            if (joint < 0) continue;
+            mSkeleton->bind(joint, convert(bone->mOffsetMatrix));
+            for (unsigned int j = 0; j < bone->mNumWeights; j++)
+            {   BoneWeight weight = { bone->mWeights[j].mVertexId, static_cast<GLushort>(joint), bone->mWeights[j].mWeight };
+                weights.push_back(weight);
+            }
+        }
+        std::vector<Influence> influences;
+        weigh(weights, remap, vertices.size(), influences);
+        mSubMeshes.back()->rig(influences);
+    }
+
+    void Mesh::rig(std::vector<Influence> const & influences)
+    {
+        // Rigged Meshes Keep Their Vertex Buffers so the CPU Path Can Rewrite Them
+        mInfluences = influences;
+        glBindVertexArray(mVertexArray);
+        glGenBuffers(1, & mVertexBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     mVertices.size() * sizeof(Vertex),
+                   & mVertices.front(), GL_DYNAMIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, position));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, uv));
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *) offsetof(Vertex, tangent));
+
+        // Bone Indices and Weights for skinned.vert
+        mGeometryBytes += mInfluences.size() * sizeof(Influence);
+        GLuint buffer;
+        glGenBuffers(1, & buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     mInfluences.size() * sizeof(Influence),
+                   & mInfluences.front(), GL_STATIC_DRAW);
+        glVertexAttribIPointer(3, 4, GL_UNSIGNED_SHORT, sizeof(Influence), (GLvoid *) offsetof(Influence, bones));
+        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Influence), (GLvoid *) offsetof(Influence, weights));
+        glEnableVertexAttribArray(3); // Bone Indices
+        glEnableVertexAttribArray(4); // Bone Weights
+
+        // The Depth Stream Also Needs to Follow the Pose
+        glBindVertexArray(mDepthArray);
+        glGenBuffers(1, & mPositionBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mPositionBuffer);
+        glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (GLvoid *) 0);
+
+        // Cleanup Buffers
+        glBindVertexArray(0);
+        glDeleteBuffers(1, & buffer);
+        skin(std::vector<glm::mat4>());
+    }
+
+    void Mesh::skin(std::vector<glm::mat4> const & palette)
+    {
+        for (auto &i : mSubMeshes) i->skin(palette);
+        if (mInfluences.empty()) return;
+
+        // An Empty Palette Restores the Bind Pose
+        std::vector<Vertex> skinned(mVertices);
+        if (!palette.empty())
+            Mirage::skin(& mVertices.front(), & mInfluences.front(), mVertices.size(), palette, & skinned.front());
+        std::vector<glm::vec3> positions(skinned.size());
+        for (std::size_t i = 0; i < skinned.size(); i++) positions[i] = skinned[i].position;
+
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, skinned.size() * sizeof(Vertex), & skinned.front());
+        glBindBuffer(GL_ARRAY_BUFFER, mPositionBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, positions.size() * sizeof(glm::vec3), & positions.front());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Mesh::extract(aiMesh const * mesh,
+                       std::vector<Vertex> & vertices,
+                       std::vector<GLuint> & indices,
+                       std::vector<GLuint> * remap)
+    {
+        // Create Vertex Data from Mesh Node; Normals and UVs are Optional
+        Vertex vertex = {};
         for (unsigned int i = 0; i < mesh->mNumVertices; i++)
         {   if (mesh->mTextureCoords[0])
             vertex.uv       = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
-            vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+            if (mesh->mNormals)
             vertex.normal   = glm::vec3(mesh->mNormals[i].x,  mesh->mNormals[i].y,  mesh->mNormals[i].z);
+            vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
             vertices.push_back(vertex);
         }
 
-        // Create Mesh Indices for Indexed Drawing
-        std::vector<GLuint> indices;
+        // Create Mesh Indices for Indexed Drawing; Points and Lines are Skipped
         for (unsigned int i = 0; i < mesh->mNumFaces; i++)
-        for (unsigned int j = 0; j < mesh->mFaces[i].mNumIndices; j++)
+        if (mesh->mFaces[i].mNumIndices == 3)
+        for (unsigned int j = 0; j < 3; j++)
             indices.push_back(mesh->mFaces[i].mIndices[j]);
 
-        // Load Mesh Textures into VRAM
-        std::map<GLuint, std::string> textures;
-        auto diffuse  = process(path, scene->mMaterials[mesh->mMaterialIndex], aiTextureType_DIFFUSE);
-        auto specular = process(path, scene->mMaterials[mesh->mMaterialIndex], aiTextureType_SPECULAR);
-        textures.insert(diffuse.begin(), diffuse.end());
-        textures.insert(specular.begin(), specular.end());
-
-        // Create New Mesh Node
-        mSubMeshes.push_back(std::unique_ptr<Mesh>(new Mesh(vertices, indices, textures)));
+        // Weld Exact Duplicates and Fill in Whatever the File Left Out. One Pool Serves Every
+        // Sub-Mesh of Every Load, so Threads are Started Once Rather Than per Call
+        static Geometry geometry;
+        GeometryOptions options = { 0.0f, true, mesh->mNormals == nullptr, mesh->mTextureCoords[0] != nullptr };
+        geometry.process(vertices, indices, options, remap);
     }
 
     std::map<GLuint, std::string> Mesh::process(std::string const & path,
                                                 aiMaterial * material,
-                                                aiTextureType type)
+                                                aiTextureType type,
+                                                std::size_t & bytes)
     {
         std::map<GLuint, std::string> textures;
         for(unsigned int i = 0; i < material->GetTextureCount(type); i++)
         {
             // Define Some Local Variables
-            GLenum format;
             GLuint texture;
             std::string mode;
 
             // Load the Texture Image from File
             aiString str; material->GetTexture(type, i, & str);
-            std::string filename = str.C_Str(); int width, height, channels;
-            filename = PROJECT_SOURCE_DIR "/Mirage/Models/" + path + "/" + filename;
-            unsigned char * image = stbi_load(filename.c_str(), & width, & height, & channels, 0);
-            if (!image) fprintf(stderr, "%s %s\n", "Failed to Load Texture", filename.c_str());
+            std::string filename = str.C_Str();
+            texture = Mesh::texture(PROJECT_SOURCE_DIR "/Mirage/Models/" + path + "/" + filename, & bytes);
+            if (texture == 0) continue;
 
-            // Set the Correct Channel Format
-            switch (channels)
-            {
-                case 1 : format = GL_ALPHA;     break;
-                case 2 : format = GL_LUMINANCE; break;
-                case 3 : format = GL_RGB;       break;
-                case 4 : format = GL_RGBA;      break;
-            }
-
-            // Bind Texture and Set Filtering Levels
-            glGenTextures(1, & texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, format,
-                         width, height, 0, format, GL_UNSIGNED_BYTE, image);
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            // Release Image Pointer and Store the Texture
-            stbi_image_free(image);
+            // Store the Texture
                  if (type == aiTextureType_DIFFUSE)  mode = "diffuse";
             else if (type == aiTextureType_SPECULAR) mode = "specular";
             textures.insert(std::make_pair(texture, mode));
         }   return textures;
     }
+
+    GLuint Mesh::texture(std::string const & filename, std::size_t * bytes)
+    {
+        int width, height, channels;
+        unsigned char * image = stbi_load(filename.c_str(), & width, & height, & channels, 0);
+        if (!image)
+        {   fprintf(stderr, "%s %s\n", "Failed to Load Texture", filename.c_str());
+            return 0;
+        }
+
+        // Drivers Usually Pad to Four Channels; the Mip Chain Adds a Third
+        GLuint texture = upload(image, width, height, channels);
+        if (bytes) *bytes += std::size_t(width) * height * 16 / 3;
+        stbi_image_free(image);
+        return texture;
+    }
+
+    void Mesh::measure(std::size_t & cpu, std::size_t & geometry, std::size_t & textures) const
+    {
+        for (auto &i : mSubMeshes) i->measure(cpu, geometry, textures);
+        cpu += mVertices.capacity()   * sizeof(Vertex)
+             + mIndices.capacity()    * sizeof(GLuint)
+             + mInfluences.capacity() * sizeof(Influence);
+        geometry += mGeometryBytes;
+        textures += mTextureBytes;
+    }
+
+    void Mesh::release()
+    {
+        // Rigged Meshes Need Their Bind Pose for CPU Skinning
+        for (auto &i : mSubMeshes) i->release();
+        if (!mInfluences.empty()) return;
+        std::vector<Vertex>().swap(mVertices);
+        std::vector<GLuint>().swap(mIndices);
+    }
+
+    GLuint Mesh::upload(unsigned char const * image, int width, int height, int channels)
+    {
+        // Set the Correct Channel Format
+        GLenum format = GL_RGBA;
+        switch (channels)
+        {
+            case 1 : format = GL_ALPHA;     break;
+            case 2 : format = GL_LUMINANCE; break;
+            case 3 : format = GL_RGB;       break;
+            case 4 : format = GL_RGBA;      break;
+        }
+
+        // Bind Texture and Set Filtering Levels
+        GLuint texture;
+        glGenTextures(1, & texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, format,
+                     width, height, 0, format, GL_UNSIGNED_BYTE, image);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        return texture;
+    }
 };
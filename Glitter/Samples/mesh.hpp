@@ -1,7 +1,13 @@
 #pragma once
 
+// Local Headers
+#include "animation.hpp"
+#include "bundle.hpp"
+#include "occlusion.hpp"
+#include "scene.hpp"
+
 // System Headers
-#include <assimp/importer.hpp>
+#include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <glad/glad.h>
@@ -20,24 +26,79 @@ namespace Mirage
         glm::vec3 position;
         glm::vec3 normal;
         glm::vec2 uv;
+        glm::vec4 tangent;  // xyz Tangent, w Bitangent Sign
     };
 
+    // Import Flags Shared by the Loader and Tools. Welding, Normals, Tangents and Degenerate
+    // Removal are Left to Mirage::Geometry, Which Runs Them on Every Core
+    static const unsigned int kImport =
+        (aiProcessPreset_TargetRealtime_MaxQuality & ~(aiProcess_JoinIdenticalVertices |
+                                                       aiProcess_GenSmoothNormals      |
+                                                       aiProcess_CalcTangentSpace      |
+                                                       aiProcess_FindDegenerates))     |
+        aiProcess_FlipUVs;
+
+    // Forward Declarations
+    class Batch;
+
     class Mesh
     {
+        // Batches Merge the CPU Copies of Sub-Meshes into Shared Buffers
+        friend class Batch;
+
     public:
 
         // Implement Default Constructor and Destructor
-         Mesh() { glGenVertexArrays(1, & mVertexArray); }
-        ~Mesh() { glDeleteVertexArrays(1, & mVertexArray); }
+         Mesh() : mDepthArray(0), mCount(0), mNode(-1), mGeometryBytes(0), mTextureBytes(0)
+                { glGenVertexArrays(1, & mVertexArray); }
+        ~Mesh();
 
         // Implement Custom Constructors
         Mesh(std::string const & filename);
+        Mesh(std::string const & filename, Scene & scene, int parent = -1);
+        Mesh(Bundle const & bundle, std::string const & filename);
         Mesh(std::vector<Vertex> const & vertices,
              std::vector<GLuint> const & indices,
              std::map<GLuint, std::string> const & textures);
 
         // Public Member Functions
         void draw(GLuint shader);
+        void draw(GLuint shader, Occlusion & occlusion,
+                  glm::mat4 const & model = glm::mat4(1.0f));
+        void occlude(Occlusion & occlusion,
+                     glm::mat4 const & model = glm::mat4(1.0f));
+
+        // Draw with Node Transforms from a Scene Bound for scene.vert; Meshes Not Loaded
+        // into the Scene Use model Instead
+        void draw(GLuint shader, Scene const & scene,
+                  glm::mat4 const & model = glm::mat4(1.0f));
+
+        // Draw Positions Only, Without Binding Textures; Returns Draw Calls Issued
+        unsigned int depth();
+
+        // Skeletal Animation, Only Present for Rigged Models
+        Skeleton const * skeleton() const { return mSkeleton.get(); }
+        std::vector<Clip> const & clips() const { return mClips; }
+        void skin(std::vector<glm::mat4> const & palette);
+
+        // Memory Held by this Mesh and its Sub-Meshes, in Bytes
+        void measure(std::size_t & cpu, std::size_t & geometry, std::size_t & textures) const;
+
+        // Drop CPU Copies of Static Geometry; Occlusion and Batching Skip the Mesh Afterwards
+        void release();
+
+        // Load an Image File into a Texture, Reporting its Approximate Size in VRAM
+        static GLuint texture(std::string const & filename, std::size_t * bytes = nullptr);
+
+        // Upload Decoded Texels, e.g. Decoded Ahead of Time on Another Thread
+        static GLuint upload(unsigned char const * image, int width, int height, int channels);
+
+        // Flatten an Assimp Mesh into Welded, Indexed Triangles with Normals and Tangents.
+        // remap Receives the Output Index of Each Assimp Vertex
+        static void extract(aiMesh const * mesh,
+                            std::vector<Vertex> & vertices,
+                            std::vector<GLuint> & indices,
+                            std::vector<GLuint> * remap = nullptr);
 
     private:
 
@@ -45,23 +106,48 @@ namespace Mirage
         Mesh(Mesh const &) = delete;
         Mesh & operator=(Mesh const &) = delete;
 
+        // Upload Directly from Caller Memory, e.g. a Mapped Bundle
+        Mesh(Vertex const * vertices, GLsizei vertexCount,
+             GLuint const * indices,  GLsizei indexCount,
+             std::map<GLuint, std::string> const & textures);
+
         // Private Member Functions
-        void parse(std::string const & path, aiNode const * node, aiScene const * scene);
+        void load(std::string const & filename, Scene * scene, int parent);
+        void upload(Vertex const * vertices, GLsizei vertexCount,
+                    GLuint const * indices,  GLsizei indexCount);
+        void render(GLuint shader);
+        void textures(GLuint shader) const;
+        void rig(std::vector<Influence> const & influences);
+        void parse(std::string const & path, aiNode const * node, aiScene const * scene,
+                   Scene * graph, int parent);
         void parse(std::string const & path, aiMesh const * mesh, aiScene const * scene);
         std::map<GLuint, std::string> process(std::string const & path,
                                               aiMaterial * material,
-                                              aiTextureType type);
+                                              aiTextureType type,
+                                              std::size_t & bytes);
 
         // Private Member Containers
         std::vector<std::unique_ptr<Mesh>> mSubMeshes;
         std::vector<GLuint> mIndices;
         std::vector<Vertex> mVertices;
         std::map<GLuint, std::string> mTextures;
+        std::vector<GLuint> mOwned;
+        std::vector<Influence> mInfluences;
+        std::vector<Clip> mClips;
+        std::unique_ptr<Skeleton> mSkeleton;
 
         // Private Member Variables
         GLuint mVertexArray;
         GLuint mVertexBuffer;
         GLuint mElementBuffer;
+        GLuint mDepthArray;
+        GLuint mPositionBuffer;
+        GLsizei mCount;
+        int mNode;
+        std::size_t mGeometryBytes;
+        std::size_t mTextureBytes;
+        glm::vec3 mMin;
+        glm::vec3 mMax;
 
     };
 };
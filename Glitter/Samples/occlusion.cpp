@@ -0,0 +1,246 @@
+// Local Headers
+#include "occlusion.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const float kNearW = 1e-5f;
+    static const float kMoved = 1e-5f;   // Relative Change That Makes the Pyramid Stale
+
+    // Cameras Match When No Matrix Element Moved More Than a Rounding Error
+    static bool same(glm::mat4 const & a, glm::mat4 const & b)
+    {
+        float largest = 0.0f, difference = 0.0f;
+        for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+        {   largest    = std::max(largest, std::fabs(a[i][j]));
+            difference = std::max(difference, std::fabs(a[i][j] - b[i][j]));
+        }   return difference <= kMoved * std::max(largest, 1.0f);
+    }
+
+    Occlusion::Occlusion(int width, int height)
+        : mViewProjection(1.0f)
+        , mDepthViewProjection(1.0f)
+        , mPendingViewProjection(1.0f)
+        , mStats()
+        , mWidth(width)
+        , mHeight(height)
+        , mTexture(0)
+        , mPixelBuffer(0)
+        , mFence(nullptr)
+    {
+        // Allocate Every Level of the Pyramid Up Front
+        glm::ivec2 size(width, height);
+        for (;;)
+        {
+            mSizes.push_back(size);
+            mLevels.push_back(std::vector<float>(size.x * size.y, 1.0f));
+            if (size.x == 1 && size.y == 1) break;
+            size = glm::ivec2((size.x + 1) / 2, (size.y + 1) / 2);
+        }
+    }
+
+    Occlusion::~Occlusion()
+    {
+        // GL Objects Only Exist if the GPU Path Was Used
+        if (mFence) glDeleteSync(mFence);
+        if (mTexture) glDeleteTextures(1, & mTexture);
+        if (mPixelBuffer) glDeleteBuffers(1, & mPixelBuffer);
+    }
+
+    void Occlusion::begin(glm::mat4 const & viewProjection)
+    {
+        mViewProjection = viewProjection;
+        mStats = OcclusionStats();
+    }
+
+    void Occlusion::clear()
+    {
+        mDepthViewProjection = mViewProjection;
+        for (auto & level : mLevels)
+            std::fill(level.begin(), level.end(), 1.0f);
+    }
+
+    void Occlusion::rasterize(glm::vec3 const * positions, std::size_t stride,
+                              GLuint const * indices, std::size_t count,
+                              glm::mat4 const & model)
+    {
+        mDepthViewProjection = mViewProjection;
+        glm::mat4 transform = mViewProjection * model;
+        auto base = reinterpret_cast<char const *>(positions);
+        auto fetch = [&](GLuint index)
+        {   auto position = reinterpret_cast<glm::vec3 const *>(base + index * stride);
+            return transform * glm::vec4(*position, 1.0f);
+        };
+        for (std::size_t i = 0; i + 2 < count; i += 3)
+            triangle(fetch(indices[i]), fetch(indices[i + 1]), fetch(indices[i + 2]));
+    }
+
+    void Occlusion::triangle(glm::vec4 const & a, glm::vec4 const & b, glm::vec4 const & c)
+    {
+        // Skip Triangles Crossing the Near Plane; Missing an Occluder is Always Safe
+        if (a.w <= kNearW || b.w <= kNearW || c.w <= kNearW) return;
+
+        // Project to Pixel Coordinates and Window Depth
+        auto project = [this](glm::vec4 const & v)
+        {   return glm::vec3((v.x / v.w * 0.5f + 0.5f) * mWidth,
+                             (v.y / v.w * 0.5f + 0.5f) * mHeight,
+                             (v.z / v.w * 0.5f + 0.5f));
+        };
+        glm::vec3 p0 = project(a), p1 = project(b), p2 = project(c);
+        float area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+        if (area == 0.0f) return;
+
+        // Clamp the Bounding Box to the Buffer
+        int x0 = std::max(0, static_cast<int>(std::floor(std::min({ p0.x, p1.x, p2.x }))));
+        int y0 = std::max(0, static_cast<int>(std::floor(std::min({ p0.y, p1.y, p2.y }))));
+        int x1 = std::min(mWidth  - 1, static_cast<int>(std::ceil(std::max({ p0.x, p1.x, p2.x }))));
+        int y1 = std::min(mHeight - 1, static_cast<int>(std::ceil(std::max({ p0.y, p1.y, p2.y }))));
+
+        // Walk Pixel Centers with Edge Functions; Occluders are Double-Sided
+        auto & depth = mLevels[0];
+        float inverse = 1.0f / area;
+        for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+        {
+            float px = x + 0.5f, py = y + 0.5f;
+            float w0 = ((p2.x - p1.x) * (py - p1.y) - (p2.y - p1.y) * (px - p1.x)) * inverse;
+            float w1 = ((p0.x - p2.x) * (py - p2.y) - (p0.y - p2.y) * (px - p2.x)) * inverse;
+            float w2 = 1.0f - w0 - w1;
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+            float z = w0 * p0.z + w1 * p1.z + w2 * p2.z;
+            float & texel = depth[y * mWidth + x];
+            if (z >= 0.0f && z < texel) texel = z;
+        }
+    }
+
+    void Occlusion::capture(GLuint depthTexture, glm::mat4 const & viewProjection)
+    {
+        // Lazily Create GPU Resources so the CPU Path Never Needs a Context
+        if (!mReduce)
+        {
+            mReduce.reset(new Shader());
+            mReduce->attach("hiz.comp").link();
+            glGenTextures(1, & mTexture);
+            glBindTexture(GL_TEXTURE_2D, mTexture);
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, mWidth, mHeight);
+            glGenBuffers(1, & mPixelBuffer);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, mPixelBuffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, mWidth * mHeight * sizeof(float), nullptr, GL_STREAM_READ);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+        // Collect the Last Readback Without Stalling; Keep the Old Pyramid Until It Lands
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, mPixelBuffer);
+        if (mFence)
+        {
+            GLenum status = glClientWaitSync(mFence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                return;
+            }
+            auto texels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, mWidth * mHeight * sizeof(float), GL_MAP_READ_BIT);
+            if (texels) std::memcpy(mLevels[0].data(), texels, mWidth * mHeight * sizeof(float));
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glDeleteSync(mFence);
+            mFence = nullptr;
+            mDepthViewProjection = mPendingViewProjection;
+            build();
+        }
+
+        // Reduce the Depth Buffer and Queue an Asynchronous Readback
+        mReduce->activate();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, depthTexture);
+        glBindImageTexture(0, mTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((mWidth + 7) / 8, (mHeight + 7) / 8, 1);
+        glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        mPendingViewProjection = viewProjection;
+    }
+
+    void Occlusion::build()
+    {
+        // Each Texel Keeps the Farthest Depth of the Texels Beneath It
+        for (std::size_t i = 1; i < mLevels.size(); i++)
+        {
+            auto & below = mLevels[i - 1]; auto size = mSizes[i - 1];
+            for (int y = 0; y < mSizes[i].y; y++)
+            for (int x = 0; x < mSizes[i].x; x++)
+            {
+                int x0 = x * 2, x1 = std::min(x0 + 1, size.x - 1);
+                int y0 = y * 2, y1 = std::min(y0 + 1, size.y - 1);
+                mLevels[i][y * mSizes[i].x + x] = std::max(
+                    std::max(below[y0 * size.x + x0], below[y0 * size.x + x1]),
+                    std::max(below[y1 * size.x + x0], below[y1 * size.x + x1]));
+            }
+        }
+    }
+
+    bool Occlusion::visible(glm::vec3 const & min, glm::vec3 const & max,
+                            glm::mat4 const & model)
+    {
+        mStats.tested++;
+        glm::mat4 transform = mViewProjection * model;
+
+        // Project the Corners; Boxes Touching the Near Plane are Always Drawn
+        glm::vec3 lo( std::numeric_limits<float>::max());
+        glm::vec3 hi(-std::numeric_limits<float>::max());
+        for (int i = 0; i < 8; i++)
+        {
+            glm::vec4 clip = transform * glm::vec4(i & 1 ? max.x : min.x,
+                                                   i & 2 ? max.y : min.y,
+                                                   i & 4 ? max.z : min.z, 1.0f);
+            if (clip.w <= kNearW) { mStats.drawn++; return true; }
+            glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            lo = glm::min(lo, ndc);
+            hi = glm::max(hi, ndc);
+        }
+
+        // Boxes Entirely Outside the Frustum are Culled Too
+        if (hi.x < -1.0f || lo.x > 1.0f || hi.y < -1.0f || lo.y > 1.0f || lo.z > 1.0f)
+        {   mStats.culled++;
+            return false;
+        }
+
+        // The Camera Moved Since the Pyramid Was Built, so its Depth No Longer Lines Up
+        if (!same(mDepthViewProjection, mViewProjection)) { mStats.drawn++; return true; }
+
+        // Convert to a Pixel Rectangle on the Finest Level
+        auto pixel = [](float ndc, int size)
+        {   return std::min(size - 1, std::max(0, static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * size))));
+        };
+        int x0 = pixel(lo.x, mWidth), x1 = pixel(hi.x, mWidth);
+        int y0 = pixel(lo.y, mHeight), y1 = pixel(hi.y, mHeight);
+        float nearest = lo.z * 0.5f + 0.5f;
+
+        // Pick the Level Where the Rectangle Covers at Most 2x2 Texels
+        std::size_t level = 0;
+        while (level + 1 < mLevels.size()
+               && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+            level++;
+
+        float farthest = 0.0f;
+        for (int y = y0 >> level; y <= y1 >> level; y++)
+        for (int x = x0 >> level; x <= x1 >> level; x++)
+            farthest = std::max(farthest, depth(level, x, y));
+
+        if (nearest > farthest) { mStats.culled++; return false; }
+        mStats.drawn++; return true;
+    }
+
+    float Occlusion::depth(int level, int x, int y) const
+    {
+        return mLevels[level][y * mSizes[level].x + x];
+    }
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+// Local Headers
+#include "shader.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Culling Counters for a Single Frame
+    struct OcclusionStats {
+        unsigned int tested;
+        unsigned int culled;
+        unsigned int drawn;
+    };
+
+    class Occlusion
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Occlusion(int width = 256, int height = 128);
+        ~Occlusion();
+
+        // Start a Frame; Resets Counters and Sets the Camera Used for Testing
+        void begin(glm::mat4 const & viewProjection);
+
+        // Depth Sources: Deterministic CPU Occluders Seen from the Current Camera, or the
+        // Previous Frame's GPU Depth Along with the Camera it Was Rendered From
+        void clear();
+        void rasterize(glm::vec3 const * positions, std::size_t stride,
+                       GLuint const * indices, std::size_t count,
+                       glm::mat4 const & model);
+        void capture(GLuint depthTexture, glm::mat4 const & viewProjection);
+
+        // Build the Pyramid After All Occluders are Rasterized
+        void build();
+
+        // Test Object-Space Bounds Against the Pyramid. Depth From Another Camera Says Nothing
+        // About What the Current One Sees, so Until the Pyramid Catches Up, Only the Frustum Culls
+        bool visible(glm::vec3 const & min, glm::vec3 const & max,
+                     glm::mat4 const & model);
+
+        // Public Accessors
+        OcclusionStats const & stats() const { return mStats; }
+        float depth(int level, int x, int y) const;
+
+    private:
+
+        // Disable Copying and Assignment
+        Occlusion(Occlusion const &) = delete;
+        Occlusion & operator=(Occlusion const &) = delete;
+
+        // Private Member Functions
+        void triangle(glm::vec4 const & a, glm::vec4 const & b, glm::vec4 const & c);
+
+        // Private Member Containers
+        std::vector<std::vector<float>> mLevels;
+        std::vector<glm::ivec2> mSizes;
+
+        // Private Member Variables
+        glm::mat4 mViewProjection;
+        glm::mat4 mDepthViewProjection;  // Camera the Pyramid Was Built From
+        glm::mat4 mPendingViewProjection; // Camera of the Readback in Flight
+        OcclusionStats mStats;
+        int mWidth;
+        int mHeight;
+
+        // Readback State for the GPU Path
+        std::unique_ptr<Shader> mReduce;
+        GLuint mTexture;
+        GLuint mPixelBuffer;
+        GLsync mFence;
+
+    };
+};
@@ -0,0 +1,218 @@
+// Local Headers
+#include "passes.hpp"
+
+// Define Namespace
+namespace Mirage
+{
+    Passes::Passes(int width, int height)
+        : mMode(PassDepthPrepass)
+        , mMeasure(false)
+        , mStats()
+        , mWidth(0)
+        , mHeight(0)
+        , mTextures()
+    {
+        mDepth.attach("depth.vert").attach("depth.frag").link();
+        mComposite.attach("composite.vert").attach("composite.frag").link();
+        glGenFramebuffers(1, & mFramebuffer);
+        glGenVertexArrays(1, & mVertexArray);
+        glGenQueries(3, mQueries);
+        resize(width, height);
+    }
+
+    Passes::~Passes()
+    {
+        glDeleteTextures(3, mTextures);
+        glDeleteFramebuffers(1, & mFramebuffer);
+        glDeleteVertexArrays(1, & mVertexArray);
+        glDeleteQueries(3, mQueries);
+    }
+
+    void Passes::resize(int width, int height)
+    {
+        if (width == mWidth && height == mHeight) return;
+        mWidth = width; mHeight = height;
+        if (mTextures[0]) glDeleteTextures(3, mTextures);
+        glGenTextures(3, mTextures);
+
+        // Premultiplied Color Sum Needs Range; Revealage Only Needs a Fraction
+        GLenum formats[3] = { GL_RGBA16F, GL_R8, GL_DEPTH_COMPONENT24 };
+        for (int i = 0; i < 3; i++)
+        {   glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+            glTexStorage2D(GL_TEXTURE_2D, 1, formats[i], width, height);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Leave the Caller's Framebuffer Bound; Scenes are Often Built Mid-Frame
+        GLint previous = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, & previous);
+        GLenum buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTextures[0], 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, mTextures[1], 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  GL_TEXTURE_2D, mTextures[2], 0);
+        glDrawBuffers(2, buffers);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            fprintf(stderr, "%s\n", "Incomplete Transparency Framebuffer");
+        glBindFramebuffer(GL_FRAMEBUFFER, previous);
+    }
+
+    bool Passes::blittable(GLuint target) const
+    {
+        // The Default Framebuffer, Stencil Formats and Multisampling All Rule Out a Depth Blit
+        if (target == 0) return false;
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        GLint type = GL_NONE, depth = 0, stencil = 0, component = GL_NONE, samples = 0;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, & type);
+        if (type == GL_NONE) return false;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, & depth);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, & stencil);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, & component);
+        glGetIntegerv(GL_SAMPLES, & samples);
+        if (depth != 24 || stencil != 0 || component != GL_UNSIGNED_NORMALIZED || samples != 0) return false;
+
+        // A Smaller Attachment Would Clip the Blit and Leave Stale Depth Behind
+        GLint name = 0, width = 0, height = 0;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, & name);
+        if (type == GL_RENDERBUFFER)
+        {   glBindRenderbuffer(GL_RENDERBUFFER, name);
+            glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH,  & width);
+            glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, & height);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        }
+        else if (type == GL_TEXTURE && GLAD_GL_VERSION_4_5)
+        {   // The Texture's Target is Unknown Here, so Query it by Name; Without 4.5 the Size
+            // Stays Zero and Depth is Redrawn, Which is Always Correct
+            GLint level = 0;
+            glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, & level);
+            glGetTextureLevelParameteriv(name, level, GL_TEXTURE_WIDTH,  & width);
+            glGetTextureLevelParameteriv(name, level, GL_TEXTURE_HEIGHT, & height);
+        }
+        return width >= mWidth && height >= mHeight;
+    }
+
+    void Passes::begin(int pass)
+    {
+        if (mMeasure) glBeginQuery(GL_SAMPLES_PASSED, mQueries[pass]);
+    }
+
+    void Passes::end(int pass, GLuint64 & fragments)
+    {
+        // Reading Back Immediately Stalls, Which is Fine for Benchmarks
+        if (!mMeasure) return;
+        glEndQuery(GL_SAMPLES_PASSED);
+        glGetQueryObjectui64v(mQueries[pass], GL_QUERY_RESULT, & fragments);
+    }
+
+    void Passes::render(GLuint target, glm::mat4 const & viewProjection,
+                        GLuint opaque, GLuint transparent,
+                        std::vector<Renderable> const & renderables)
+    {
+        mStats = OverdrawStats();
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        glViewport(0, 0, mWidth, mHeight);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+
+        // Depth from the Position-Only Stream, Pushed Back Slightly so Shading Passes
+        // Still Match Even Though Their Shaders Transform Positions Differently
+        if (mMode == PassDepthPrepass)
+        {
+            mDepth.activate();
+            mDepth.bind("viewProjection", viewProjection);
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(1.0f, 1.0f);
+            begin(0);
+            for (auto & renderable : renderables)
+            {   if (renderable.tint.w < 1.0f) continue;
+                mDepth.bind("model", renderable.model);
+                renderable.mesh->depth();
+            }
+            end(0, mStats.prepass);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glDepthFunc(GL_LEQUAL);
+            glDepthMask(GL_FALSE);
+        }
+
+        // Opaque Shading: with a Pre-Pass, Each Pixel is Shaded About Once
+        glUseProgram(opaque);
+        GLint model = glGetUniformLocation(opaque, "model");
+        begin(1);
+        for (auto & renderable : renderables)
+        {   if (renderable.tint.w < 1.0f) continue;
+            glUniformMatrix4fv(model, 1, GL_FALSE, & renderable.model[0][0]);
+            renderable.mesh->draw(opaque);
+        }
+        end(1, mStats.opaque);
+        mStats.overdraw = static_cast<double>(mStats.opaque) / (mWidth * mHeight);
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+
+        // Nothing Transparent, Nothing More to Do
+        bool any = false;
+        for (auto & renderable : renderables) any |= renderable.tint.w < 1.0f;
+        if (!any) return;
+
+        // Test Against Opaque Depth Without Writing it; Order No Longer Matters. Blits Need
+        // Matching Depth Formats, so Other Targets Get Opaque Depth Redrawn from Positions
+        GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, one[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        if (blittable(target))
+        {   glBindFramebuffer(GL_READ_FRAMEBUFFER, target);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
+            glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        }
+        else
+        {   glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            mDepth.activate();
+            mDepth.bind("viewProjection", viewProjection);
+            for (auto & renderable : renderables)
+            {   if (renderable.tint.w < 1.0f) continue;
+                mDepth.bind("model", renderable.model);
+                renderable.mesh->depth();
+            }
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        }
+        glClearBufferfv(GL_COLOR, 0, zero);
+        glClearBufferfv(GL_COLOR, 1, one);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendFunci(0, GL_ONE, GL_ONE);
+        glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+        glUseProgram(transparent);
+        model = glGetUniformLocation(transparent, "model");
+        GLint tint = glGetUniformLocation(transparent, "tint");
+        begin(2);
+        for (auto & renderable : renderables)
+        {   if (renderable.tint.w >= 1.0f) continue;
+            glUniformMatrix4fv(model, 1, GL_FALSE, & renderable.model[0][0]);
+            glUniform4fv(tint, 1, & renderable.tint[0]);
+            renderable.mesh->draw(transparent);
+        }
+        end(2, mStats.transparent);
+
+        // Resolve the Weighted Average over the Opaque Image
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        glDisable(GL_DEPTH_TEST);
+        glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+        mComposite.activate();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mTextures[0]);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, mTextures[1]);
+        glBindVertexArray(mVertexArray);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glActiveTexture(GL_TEXTURE0);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+    }
+};
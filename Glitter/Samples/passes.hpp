@@ -0,0 +1,91 @@
+#pragma once
+
+// Local Headers
+#include "mesh.hpp"
+#include "shader.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // How Opaque Geometry is Drawn
+    enum PassMode {
+        PassForward,       // Shade Everything that Passes the Depth Test as it Arrives
+        PassDepthPrepass,  // Lay Down Depth from Positions First, then Shade Visible Pixels Once
+    };
+
+    // Something to Draw; Transparent When tint.w is Less Than One
+    struct Renderable {
+        Mesh *    mesh;
+        glm::mat4 model;
+        glm::vec4 tint;
+    };
+
+    // Fragments Counted with Occlusion Queries, Only While Measuring
+    struct OverdrawStats {
+        GLuint64 prepass;       // Depth-Only Fragments
+        GLuint64 opaque;        // Fragments Shaded by the Opaque Pass
+        GLuint64 transparent;   // Fragments Accumulated by the Transparent Pass
+        double   overdraw;      // Opaque Fragments Shaded per Pixel
+    };
+
+    class Passes
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Passes(int width, int height);
+        ~Passes();
+
+        // Reallocate the Transparency Targets
+        void resize(int width, int height);
+
+        // Draw Opaque Renderables with the Given Shader, Then Blend Transparent Ones into the
+        // Target Using Weighted-Blended Order-Independent Transparency. Both Shaders Must
+        // Already Have Their View and Projection Uniforms Set; "model" is Set per Renderable.
+        // Opaque Depth is Blitted When the Target Has a Single-Sample DEPTH_COMPONENT24
+        // Attachment at Least as Large; Any Other Target, Including the Default Framebuffer,
+        // Gets it Redrawn from the Position Stream Instead
+        void render(GLuint target, glm::mat4 const & viewProjection,
+                    GLuint opaque, GLuint transparent,
+                    std::vector<Renderable> const & renderables);
+
+        // Public Member Functions
+        void mode(PassMode mode) { mMode = mode; }
+        void measure(bool enabled) { mMeasure = enabled; }
+
+        // Public Accessors
+        OverdrawStats const & stats() const { return mStats; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Passes(Passes const &) = delete;
+        Passes & operator=(Passes const &) = delete;
+
+        // Private Member Functions
+        bool blittable(GLuint target) const;
+        void begin(int pass);
+        void end(int pass, GLuint64 & fragments);
+
+        // Private Member Variables
+        Shader   mDepth;
+        Shader   mComposite;
+        PassMode mMode;
+        bool     mMeasure;
+        OverdrawStats mStats;
+        int      mWidth;
+        int      mHeight;
+        GLuint   mFramebuffer;
+        GLuint   mTextures[3];   // Accumulation, Revealage, Depth
+        GLuint   mVertexArray;
+        GLuint   mQueries[3];
+
+    };
+};
@@ -0,0 +1,244 @@
+// Local Headers
+#include "resources.hpp"
+
+// System Headers
+#include <sys/stat.h>
+
+// Standard Headers
+#include <algorithm>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const std::size_t kReported = 10;  // Largest Assets Listed in a Dump
+    static const double      kMegabyte = 1024.0 * 1024.0;
+
+    // Modification Time of a File, or Zero if it Does Not Exist
+    static std::time_t modified(std::string const & filename)
+    {
+        struct stat info;
+        return stat(filename.c_str(), & info) == 0 ? info.st_mtime : 0;
+    }
+
+    bool enforce(std::vector<ResourceInfo *> const & assets, ResourceBudget const & budget,
+                 unsigned long frame, ResourceUsage & total,
+                 std::function<std::size_t(std::size_t)> const & release,
+                 std::function<void(std::size_t)> const & evict)
+    {
+        // Over the CPU Budget: First Drop CPU Copies, Least Recently Used Meshes First
+        if (budget.cpu && total.cpu > budget.cpu)
+        {
+            std::vector<std::size_t> candidates;
+            for (std::size_t i = 0; i < assets.size(); i++)
+                if (assets[i]->resident && assets[i]->usage[ResourceGeometry].cpu > 0
+                    && assets[i]->lastUsed != frame)
+                    candidates.push_back(i);
+            std::stable_sort(candidates.begin(), candidates.end(), [&](std::size_t a, std::size_t b)
+                             { return assets[a]->lastUsed < assets[b]->lastUsed; });
+            for (auto i : candidates)
+            {
+                if (total.cpu <= budget.cpu) break;
+                total.cpu -= std::min(total.cpu, release(i));
+            }
+        }
+
+        // Still Over Either Budget: Evict Whole Assets, Oldest First. Anything Used This
+        // Frame May Still be Referenced by the Caller
+        while ((budget.cpu && total.cpu > budget.cpu) || (budget.gpu && total.gpu > budget.gpu))
+        {
+            std::size_t victim = assets.size();
+            for (std::size_t i = 0; i < assets.size(); i++)
+            {
+                if (!assets[i]->resident || assets[i]->lastUsed == frame) continue;
+                if (victim == assets.size() || assets[i]->lastUsed < assets[victim]->lastUsed) victim = i;
+            }
+            if (victim == assets.size()) return false;
+            for (auto & usage : assets[victim]->usage)
+            {   total.cpu -= std::min(total.cpu, usage.cpu);
+                total.gpu -= std::min(total.gpu, usage.gpu);
+            }
+            evict(victim);
+        }   return true;
+    }
+
+    Resources::Resources(ResourceBudget const & budget)
+        : mBudget(budget)
+        , mCurrent()
+        , mLast()
+        , mWarned(false)
+    {
+        // Frame Zero Means Never Used
+        mCurrent.frame = 1;
+    }
+
+    Resources::~Resources()
+    {
+        for (auto & asset : mAssets)
+            if (asset.second.texture) glDeleteTextures(1, & asset.second.texture);
+    }
+
+    Resources::Asset & Resources::acquire(std::string const & name)
+    {
+        Asset & asset = mAssets[name];
+        asset.info.name = name;
+        if (asset.info.lastUsed != mCurrent.frame) mCurrent.touched++;
+        asset.info.lastUsed = mCurrent.frame;
+        return asset;
+    }
+
+    Mesh * Resources::mesh(std::string const & filename)
+    {
+        Asset & asset = acquire(filename);
+        if (!asset.mesh)
+        {   asset.mesh.reset(new Mesh(filename));
+            asset.info.loads++;
+            asset.info.resident = true;
+            measure(asset);
+            for (auto & usage : asset.info.usage)
+            {   mCurrent.loaded.cpu += usage.cpu;
+                mCurrent.loaded.gpu += usage.gpu;
+            }
+        }   return asset.mesh.get();
+    }
+
+    GLuint Resources::texture(std::string const & filename)
+    {
+        // A File That Failed to Load is Only Retried Once it Changes, Not Every Frame
+        Asset & asset = acquire(filename);
+        std::string path = PROJECT_SOURCE_DIR "/Mirage/Models/" + filename;
+        if (!asset.texture && !(asset.info.failed && modified(path) == asset.stamp))
+        {   std::size_t bytes = 0;
+            asset.texture = Mesh::texture(path, & bytes);
+            asset.info.failed   = asset.texture == 0;
+            asset.info.resident = asset.texture != 0;
+            asset.stamp = asset.info.failed ? modified(path) : 0;
+            if (asset.info.failed) return 0;
+            asset.info.loads++;
+            asset.info.usage[ResourceTexture].gpu = bytes;
+            mCurrent.loaded.gpu += bytes;
+        }   return asset.texture;
+    }
+
+    void Resources::measure(Asset & asset)
+    {
+        std::size_t cpu = 0, geometry = 0, textures = 0;
+        if (asset.mesh) asset.mesh->measure(cpu, geometry, textures);
+        asset.info.usage[ResourceGeometry].cpu = cpu;
+        asset.info.usage[ResourceGeometry].gpu = geometry;
+        asset.info.usage[ResourceTexture].cpu  = 0;
+        asset.info.usage[ResourceTexture].gpu  = textures;
+    }
+
+    void Resources::evict(Asset & asset)
+    {
+        for (auto & usage : asset.info.usage)
+        {   mCurrent.released.cpu += usage.cpu;
+            mCurrent.released.gpu += usage.gpu;
+            usage = ResourceUsage();
+        }
+        if (asset.texture) glDeleteTextures(1, & asset.texture);
+        asset.texture = 0;
+        asset.mesh.reset();
+        asset.info.resident = false;
+        mCurrent.evicted++;
+    }
+
+    void Resources::frame()
+    {
+        std::vector<Asset *> records;
+        std::vector<ResourceInfo *> infos;
+        for (auto & asset : mAssets)
+        {   records.push_back(& asset.second);
+            infos.push_back(& asset.second.info);
+        }
+
+        // Stripping a Mesh Only Frees What it Reports Afterwards; Rigged Meshes Keep Theirs
+        auto release = [&](std::size_t i)
+        {   Asset & asset = *records[i];
+            std::size_t before = asset.info.usage[ResourceGeometry].cpu;
+            if (asset.mesh) asset.mesh->release();
+            measure(asset);
+            std::size_t freed = before - std::min(before, asset.info.usage[ResourceGeometry].cpu);
+            mCurrent.released.cpu += freed;
+            return freed;
+        };
+        auto discard = [&](std::size_t i) { evict(*records[i]); };
+
+        ResourceUsage total = usage();
+        if (!enforce(infos, mBudget, mCurrent.frame, total, release, discard))
+        {   if (!mWarned) fprintf(stderr, "%s\n", "Resource Budget Exceeded by Assets in Use");
+            mWarned = true;
+        }
+
+        // Close Out the Frame
+        mCurrent.resident = total;
+        mLast = mCurrent;
+        if (mBudget.interval && mLast.frame % mBudget.interval == 0) dump();
+        mCurrent = ResourceFrame();
+        mCurrent.frame = mLast.frame + 1;
+    }
+
+    ResourceUsage Resources::usage() const
+    {
+        ResourceUsage total = ResourceUsage();
+        for (int i = 0; i < ResourceCategories; i++)
+        {   ResourceUsage category = usage(static_cast<ResourceCategory>(i));
+            total.cpu += category.cpu;
+            total.gpu += category.gpu;
+        }   return total;
+    }
+
+    ResourceUsage Resources::usage(ResourceCategory category) const
+    {
+        ResourceUsage total = ResourceUsage();
+        for (auto & asset : mAssets)
+        {   total.cpu += asset.second.info.usage[category].cpu;
+            total.gpu += asset.second.info.usage[category].gpu;
+        }   return total;
+    }
+
+    std::vector<ResourceInfo> Resources::assets() const
+    {
+        std::vector<ResourceInfo> assets;
+        for (auto & asset : mAssets) assets.push_back(asset.second.info);
+        return assets;
+    }
+
+    void Resources::dump(FILE * stream) const
+    {
+        ResourceUsage total = usage();
+        fprintf(stream, "resources @ frame %lu: cpu %.1f MB, gpu %.1f MB (budget %.1f / %.1f MB)\n",
+                mLast.frame, total.cpu / kMegabyte, total.gpu / kMegabyte,
+                mBudget.cpu / kMegabyte, mBudget.gpu / kMegabyte);
+        fprintf(stream, "    last frame: %u touched, %.1f MB loaded, %.1f MB released, %u evicted\n",
+                mLast.touched, (mLast.loaded.cpu + mLast.loaded.gpu) / kMegabyte,
+                (mLast.released.cpu + mLast.released.gpu) / kMegabyte, mLast.evicted);
+        char const * names[ResourceCategories] = { "geometry", "textures" };
+        for (int i = 0; i < ResourceCategories; i++)
+        {   ResourceUsage category = usage(static_cast<ResourceCategory>(i));
+            fprintf(stream, "    %-10s cpu %8.1f MB, gpu %8.1f MB\n", names[i],
+                    category.cpu / kMegabyte, category.gpu / kMegabyte);
+        }
+
+        // Largest Resident Assets First
+        auto list = assets();
+        auto bytes = [](ResourceInfo const & info)
+        {   std::size_t sum = 0;
+            for (auto & usage : info.usage) sum += usage.cpu + usage.gpu;
+            return sum;
+        };
+        std::sort(list.begin(), list.end(), [&](ResourceInfo const & a, ResourceInfo const & b)
+                  { return bytes(a) > bytes(b); });
+        for (std::size_t i = 0; i < std::min(list.size(), kReported); i++)
+        {
+            auto & info = list[i];
+            if (!info.resident) break;
+            fprintf(stream, "    %-40s cpu %8.1f MB, gpu %8.1f MB, last frame %lu, loads %u\n",
+                    info.name.c_str(),
+                    (info.usage[ResourceGeometry].cpu + info.usage[ResourceTexture].cpu) / kMegabyte,
+                    (info.usage[ResourceGeometry].gpu + info.usage[ResourceTexture].gpu) / kMegabyte,
+                    info.lastUsed, info.loads);
+        }
+    }
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+// Local Headers
+#include "mesh.hpp"
+
+// System Headers
+#include <glad/glad.h>
+
+// Standard Headers
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Where the Bytes of an Asset Live
+    enum ResourceCategory {
+        ResourceGeometry,  // Vertex, Index and Skinning Buffers
+        ResourceTexture,   // Textures, Including Those Owned by Meshes
+        ResourceCategories
+    };
+
+    // Bytes on Either Side of the Bus
+    struct ResourceUsage {
+        std::size_t cpu;
+        std::size_t gpu;
+    };
+
+    // Zero Means Unlimited; Reports are Dumped Every interval Frames, or Never if Zero
+    struct ResourceBudget {
+        std::size_t  cpu;
+        std::size_t  gpu;
+        unsigned int interval;
+    };
+
+    // Snapshot of a Single Asset
+    struct ResourceInfo {
+        std::string   name;
+        ResourceUsage usage[ResourceCategories];
+        unsigned long lastUsed;   // Frame Number
+        unsigned int  loads;      // Greater Than One Once the Asset Was Reloaded
+        bool          resident;
+        bool          failed;     // Last Load Failed; Retried Only Once the File Changes
+    };
+
+    // What Happened During a Single Frame
+    struct ResourceFrame {
+        unsigned long frame;
+        unsigned int  touched;
+        unsigned int  evicted;
+        ResourceUsage resident;
+        ResourceUsage loaded;
+        ResourceUsage released;
+    };
+
+    // Bring Usage Back Under Budget, Least Recently Used First: Over the CPU Budget, First
+    // release CPU Copies of Meshes, Then evict Whole Assets Until Both Budgets Hold. Both
+    // Take an Index into assets; release Returns the Bytes it Freed. Assets Used in frame
+    // are Never Touched. total is Updated, and False Means Only Assets in Use Remain
+    bool enforce(std::vector<ResourceInfo *> const & assets, ResourceBudget const & budget,
+                 unsigned long frame, ResourceUsage & total,
+                 std::function<std::size_t(std::size_t)> const & release,
+                 std::function<void(std::size_t)> const & evict);
+
+    class Resources
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Resources(ResourceBudget const & budget);
+        ~Resources();
+
+        // Acquire Assets Every Frame They are Used; Evicted Assets Reload on Demand.
+        // Pointers and Names Stay Valid Until the Next Call to frame()
+        Mesh * mesh(std::string const & filename);
+        GLuint texture(std::string const & filename);
+
+        // End of Frame: Enforce the Budget and Dump a Report When One is Due
+        void frame();
+        void dump(FILE * stream = stderr) const;
+
+        // Public Member Functions
+        void budget(ResourceBudget const & budget) { mBudget = budget; }
+        ResourceUsage usage() const;
+        ResourceUsage usage(ResourceCategory category) const;
+        std::vector<ResourceInfo> assets() const;
+
+        // Public Accessors
+        ResourceFrame const & last() const { return mLast; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Resources(Resources const &) = delete;
+        Resources & operator=(Resources const &) = delete;
+
+        // A Mesh or a Standalone Texture, Resident or Not
+        struct Asset {
+            std::unique_ptr<Mesh> mesh;
+            GLuint texture;
+            std::time_t stamp;    // Modification Time of a File That Failed to Load
+            ResourceInfo info;
+        };
+
+        // Private Member Functions
+        Asset & acquire(std::string const & name);
+        void measure(Asset & asset);
+        void evict(Asset & asset);
+
+        // Private Member Containers
+        std::map<std::string, Asset> mAssets;
+
+        // Private Member Variables
+        ResourceBudget mBudget;
+        ResourceFrame  mCurrent;
+        ResourceFrame  mLast;
+        bool           mWarned;
+
+    };
+};
@@ -0,0 +1,128 @@
+// Local Headers
+#include "scene.hpp"
+#include "animation.hpp"
+
+// Standard Headers
+#include <algorithm>
+
+// Define Namespace
+namespace Mirage
+{
+    // Uploading the Span Between Runs is Cheaper Than Many Tiny Uploads
+    static const std::size_t kMaxRuns = 32;
+
+    Scene::~Scene()
+    {
+        if (mBuffer) glDeleteBuffers(1, & mBuffer);
+    }
+
+    int Scene::add(std::string const & name, int parent, glm::mat4 const & local)
+    {
+        int node = mParents.size();
+        if (parent >= node)
+        {   fprintf(stderr, "%s %s\n", "Parent Must Precede Node", name.c_str());
+            parent = -1;
+        }
+
+        // Link the New Node in Front of its Siblings
+        mParents.push_back(parent);
+        mDepths.push_back(parent >= 0 ? mDepths[parent] + 1 : 0);
+        mFirstChild.push_back(-1);
+        mNextSibling.push_back(parent >= 0 ? mFirstChild[parent] : -1);
+        if (parent >= 0) mFirstChild[parent] = node;
+        mNames.push_back(name);
+        mLocals.push_back(local);
+        mWorlds.push_back(local);
+        mMarks.push_back(Clean);
+        set(node, local);
+        return node;
+    }
+
+    int Scene::find(std::string const & name) const
+    {
+        auto found = std::find(mNames.begin(), mNames.end(), name);
+        return found == mNames.end() ? -1 : found - mNames.begin();
+    }
+
+    void Scene::set(int node, glm::mat4 const & local)
+    {
+        mLocals[node] = local;
+        if (mMarks[node] != Clean) return;
+        mMarks[node] = Changed;
+        mChanged.push_back(node);
+    }
+
+    unsigned int Scene::update()
+    {
+        // Gather Each Changed Subtree Once, Even When Changed Roots are Nested
+        mPending.clear();
+        std::vector<int> & stack = mChanged;
+        while (!stack.empty())
+        {
+            int node = stack.back(); stack.pop_back();
+            if (mMarks[node] == Gathered) continue;
+            mMarks[node] = Gathered;
+            mPending.push_back(node);
+            for (int child = mFirstChild[node]; child >= 0; child = mNextSibling[child])
+                if (mMarks[child] != Gathered) stack.push_back(child);
+        }
+
+        // Bucket by Depth in Linear Time; a Level Only Reads the Level Above, so Each One
+        // is a Single Batch of Independent SSE Multiplies
+        mCounts.assign(1, 0);
+        for (int node : mPending)
+        {   if (mCounts.size() < mDepths[node] + 2u) mCounts.resize(mDepths[node] + 2, 0);
+            mCounts[mDepths[node] + 1]++;
+        }
+        for (std::size_t level = 1; level < mCounts.size(); level++) mCounts[level] += mCounts[level - 1];
+        mLevels.resize(mPending.size());
+        for (int node : mPending) mLevels[mCounts[mDepths[node]]++] = node;
+
+        std::size_t begin = 0;
+        for (std::size_t level = 0; level + 1 < mCounts.size(); level++)
+        {
+            std::size_t end = mCounts[level];
+            for (std::size_t i = begin; i < end; i++)
+            {   int node = mLevels[i];
+                if (mParents[node] < 0) mWorlds[node] = mLocals[node];
+                else multiply(mWorlds[mParents[node]], mLocals[node], mWorlds[node]);
+                mMarks[node] = Clean;
+            }
+            begin = end;
+        }
+
+        mStale.insert(mStale.end(), mPending.begin(), mPending.end());
+        return mPending.size();
+    }
+
+    void Scene::bind(GLuint binding)
+    {
+        if (!mBuffer) glGenBuffers(1, & mBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBuffer);
+
+        // Growing the Buffer Means Every Matrix Has to Go Up Again
+        if (mWorlds.size() > mCapacity)
+        {   mCapacity = mWorlds.capacity();
+            glBufferData(GL_SHADER_STORAGE_BUFFER, mCapacity * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, mWorlds.size() * sizeof(glm::mat4), mWorlds.data());
+            mStale.clear();
+        }
+
+        // Otherwise Upload Only Contiguous Runs of Changed Matrices
+        std::sort(mStale.begin(), mStale.end());
+        mStale.erase(std::unique(mStale.begin(), mStale.end()), mStale.end());
+        std::vector<std::pair<int, int>> runs;
+        for (int node : mStale)
+            if (!runs.empty() && runs.back().second == node) runs.back().second++;
+            else runs.push_back(std::make_pair(node, node + 1));
+        if (runs.size() > kMaxRuns)
+            runs.assign(1, std::make_pair(runs.front().first, runs.back().second));
+        for (auto & run : runs)
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, run.first * sizeof(glm::mat4),
+                            (run.second - run.first) * sizeof(glm::mat4), & mWorlds[run.first]);
+        mStale.clear();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, mBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <string>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    class Scene
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor
+         Scene() : mBuffer(0), mCapacity(0) {}
+        ~Scene();
+
+        // Nodes Must be Added After Their Parent, so Indices are Topologically Ordered
+        int  add(std::string const & name, int parent, glm::mat4 const & local);
+        int  find(std::string const & name) const;
+
+        // Changing a Node Marks its Subtree for the Next Update
+        void set(int node, glm::mat4 const & local);
+
+        // Recompute World Matrices of Changed Subtrees Only; Returns Nodes Recomputed
+        unsigned int update();
+
+        // Upload Changed World Matrices and Bind Them for scene.vert
+        void bind(GLuint binding = 5);
+
+        // Public Accessors
+        std::size_t size() const { return mParents.size(); }
+        int parent(int node) const { return mParents[node]; }
+        glm::mat4 const & local(int node) const { return mLocals[node]; }
+        glm::mat4 const & world(int node) const { return mWorlds[node]; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Scene(Scene const &) = delete;
+        Scene & operator=(Scene const &) = delete;
+
+        // Node State During an Update
+        enum Mark : unsigned char { Clean, Changed, Gathered };
+
+        // Hierarchy as Parallel Arrays; Children are Threaded Through Sibling Links
+        std::vector<int> mParents;
+        std::vector<int> mDepths;
+        std::vector<int> mFirstChild;
+        std::vector<int> mNextSibling;
+        std::vector<std::string> mNames;
+
+        // Transforms, Indexed by Node
+        std::vector<glm::mat4> mLocals;
+        std::vector<glm::mat4> mWorlds;
+        std::vector<Mark> mMarks;
+
+        // Work Lists, Kept Between Frames to Avoid Reallocating
+        std::vector<int> mChanged;  // Roots of Changed Subtrees
+        std::vector<int> mPending;  // Nodes to Recompute This Update
+        std::vector<int> mLevels;   // Pending Nodes Bucketed by Depth
+        std::vector<std::size_t> mCounts;   // Offsets of Each Depth in mLevels
+        std::vector<int> mStale;    // Nodes Whose GPU Copy is Out of Date
+
+        // Private Member Variables
+        GLuint mBuffer;
+        std::size_t mCapacity;
+
+    };
+};
@@ -26,7 +26,23 @@ namespace Mirage
         std::ifstream fd(path + filename);
         auto src = std::string(std::istreambuf_iterator<char>(fd),
                               (std::istreambuf_iterator<char>()));
+        return compile(filename, src);
+    }
+
+    Shader & Shader::attach(Bundle const & bundle, std::string const & filename)
+    {
+        // Load GLSL Shader Source from a Mapped Bundle
+        auto entry = bundle.find(filename);
+        if (!entry || entry->type != BundleShader)
+        {   fprintf(stderr, "%s %s\n", "Missing Bundle Entry", filename.c_str());
+            return *this;
+        }
+        auto data = static_cast<char const *>(bundle.data(*entry));
+        return compile(filename, std::string(data, entry->size));
+    }
 
+    Shader & Shader::compile(std::string const & filename, std::string const & src)
+    {
         // Create a Shader Object
         const char * source = src.c_str();
         auto shader = create(filename);
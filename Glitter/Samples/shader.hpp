@@ -1,5 +1,8 @@
 #pragma once
 
+// Local Headers
+#include "bundle.hpp"
+
 // System Headers
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -22,6 +25,7 @@ namespace Mirage
         // Public Member Functions
         Shader & activate();
         Shader & attach(std::string const & filename);
+        Shader & attach(Bundle const & bundle, std::string const & filename);
         GLuint   create(std::string const & filename);
         GLuint   get() { return mProgram; }
         Shader & link();
@@ -43,6 +47,9 @@ namespace Mirage
         Shader(Shader const &) = delete;
         Shader & operator=(Shader const &) = delete;
 
+        // Private Member Functions
+        Shader & compile(std::string const & filename, std::string const & src);
+
         // Private Member Variables
         GLuint mProgram;
         GLint  mStatus;
@@ -0,0 +1,336 @@
+// Local Headers
+#include "shadows.hpp"
+
+// System Headers
+#include <glm/gtc/matrix_transform.hpp>
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const int   kMinimumTile = 128;
+    static const float kCasterDepth = 50.0f; // Extra Range Toward the Light for Off-Screen Casters
+    static const std::size_t kMaxViews = 16; // Length of shadowMatrices in clustered.frag
+
+    // Round Requested Resolutions to a Power of Two the Allocator Can Serve
+    static int fit(int resolution, int size)
+    {
+        int tile = kMinimumTile;
+        while (tile < resolution && tile < size) tile *= 2;
+        return tile;
+    }
+
+    // Buddies Only Tile the Atlas When its Size is a Power of Two No Smaller Than a Tile
+    static int atlas(int size)
+    {
+        int valid = kMinimumTile;
+        while (valid <= size / 2) valid *= 2;
+        if (valid != size) fprintf(stderr, "%s %d, Using %d\n", "Invalid Shadow Atlas Size", size, valid);
+        return valid;
+    }
+
+    Shadows::Shadows(int size)
+        : mStats()
+        , mSize(atlas(size))
+        , mDeclared(0)
+        , mEnded(false)
+        , mAtlas(0)
+        , mStatic(0)
+        , mFramebuffers()
+    {
+        // One Free List per Level, Down to the Smallest Tile
+        for (int tile = mSize; tile >= kMinimumTile; tile /= 2)
+            mFree.push_back(std::set<std::pair<int, int>>());
+        mFree[0].insert(std::make_pair(0, 0));
+    }
+
+    Shadows::~Shadows()
+    {
+        if (!mAtlas) return;
+        GLuint textures[2] = { mAtlas, mStatic };
+        glDeleteTextures(2, textures);
+        glDeleteFramebuffers(2, mFramebuffers);
+    }
+
+    void Shadows::create()
+    {
+        // The Atlas is Sampled with Depth Comparison; the Static Cache is Only Copied
+        GLuint textures[2];
+        glGenTextures(2, textures);
+        mAtlas = textures[0]; mStatic = textures[1];
+        for (auto texture : textures)
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, mSize, mSize);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        glBindTexture(GL_TEXTURE_2D, mAtlas);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+        // Depth-Only Framebuffers; render() Restores the Caller's Binding
+        glGenFramebuffers(2, mFramebuffers);
+        for (int i = 0; i < 2; i++)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, textures[i], 0);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        mShader.reset(new Shader());
+        mShader->attach("depth.vert").attach("depth.frag").link();
+    }
+
+    void Shadows::begin()
+    {
+        mDeclared = 0;
+        mEnded = false;
+    }
+
+    int Shadows::cascade(glm::vec3 const & direction, glm::mat4 const & view,
+                         float fov, float aspect, float near, float far,
+                         int index, int count, int resolution)
+    {
+        // Practical Split Scheme, Halfway Between Uniform and Logarithmic
+        auto split = [&](int i)
+        {   float t = static_cast<float>(i) / count;
+            return glm::mix(near + (far - near) * t, near * std::pow(far / near, t), 0.5f);
+        };
+        float front = split(index), back = split(index + 1);
+
+        // Bounding Sphere of the Slice; its Size Does Not Change as the Camera Turns
+        glm::mat4 inverse = glm::inverse(view);
+        float y = std::tan(fov * 0.5f), x = y * aspect;
+        glm::vec3 corners[8], center(0.0f);
+        for (int i = 0; i < 8; i++)
+        {
+            float depth = i & 4 ? back : front;
+            corners[i] = glm::vec3(inverse * glm::vec4((i & 1 ? x : -x) * depth,
+                                                       (i & 2 ? y : -y) * depth, -depth, 1.0f));
+            center += corners[i] / 8.0f;
+        }
+        float radius = 0.0f;
+        for (auto & corner : corners) radius = std::max(radius, glm::length(corner - center));
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // Snap the Center to Whole Texels so a Still Camera Reuses the Cached Depth
+        int size = fit(resolution, mSize);
+        glm::vec3 up = std::fabs(direction.y) > 0.99f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        glm::mat4 light = glm::lookAt(glm::vec3(0.0f), direction, up);
+        glm::vec3 origin = glm::vec3(light * glm::vec4(center, 1.0f));
+        float texel = 2.0f * radius / size;
+        origin.x = std::floor(origin.x / texel) * texel;
+        origin.y = std::floor(origin.y / texel) * texel;
+        glm::mat4 projection = glm::ortho(origin.x - radius, origin.x + radius,
+                                          origin.y - radius, origin.y + radius,
+                                         -origin.z - radius - kCasterDepth,
+                                         -origin.z + radius);
+        return declare(projection * light, size);
+    }
+
+    int Shadows::point(glm::vec3 const & position, float radius, int face, int resolution)
+    {
+        // Cube Map Face Conventions
+        static const glm::vec3 directions[6] = {
+            glm::vec3( 1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0,  1, 0),
+            glm::vec3( 0,-1, 0), glm::vec3( 0, 0, 1), glm::vec3(0,  0,-1) };
+        static const glm::vec3 ups[6] = {
+            glm::vec3( 0,-1, 0), glm::vec3( 0,-1, 0), glm::vec3(0,  0, 1),
+            glm::vec3( 0, 0,-1), glm::vec3( 0,-1, 0), glm::vec3(0, -1, 0) };
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.05f, radius);
+        glm::mat4 view = glm::lookAt(position, position + directions[face], ups[face]);
+        return declare(projection * view, fit(resolution, mSize));
+    }
+
+    int Shadows::declare(glm::mat4 const & viewProjection, int size)
+    {
+        // Views Keep Their Slot, Tile and Cached Depth While Nothing Changes
+        int index = mDeclared++;
+        if (index == static_cast<int>(mSlots.size()))
+        {   Slot slot = { viewProjection, glm::ivec4(0, 0, 0, 0), false, false, false };
+            mSlots.push_back(slot);
+        }
+
+        Slot & slot = mSlots[index];
+        if (slot.rect.z != size)
+        {
+            if (slot.rect.z > 0) release(slot.rect);
+            if (!allocate(size, slot.rect))
+            {   fprintf(stderr, "%s %d\n", "Shadow Atlas Full, Dropping View", index);
+                slot.rect = glm::ivec4(0, 0, 0, 0);
+            }
+            slot.valid = false;
+        }
+        if (slot.viewProjection != viewProjection)
+        {   slot.viewProjection = viewProjection;
+            slot.valid = false;
+        }
+        return index;
+    }
+
+    void Shadows::end()
+    {
+        if (mEnded) return;
+        mEnded = true;
+
+        // Views Not Declared This Frame Give Back Their Tiles
+        for (std::size_t i = mDeclared; i < mSlots.size(); i++)
+            if (mSlots[i].rect.z > 0) release(mSlots[i].rect);
+        mSlots.resize(mDeclared);
+
+        // Static Casters Only Redraw When the View Changes
+        mStats.cached = 0;
+        for (auto & slot : mSlots)
+        {   if (slot.rect.z == 0) continue;
+            slot.refresh = !slot.valid;
+            if (slot.valid) mStats.cached++;
+            slot.valid = true;
+        }
+
+        // Utilization is Everything Not on a Free List
+        float free = 0.0f;
+        for (std::size_t level = 0; level < mFree.size(); level++)
+            free += mFree[level].size() * std::pow(0.25f, static_cast<float>(level));
+        mStats.utilization = 1.0f - free;
+    }
+
+    void Shadows::render(std::vector<ShadowCaster> const & casters)
+    {
+        end();
+        GLint previous = 0, viewport[4];
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, & previous);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        if (!mShader) create();
+
+        mStats.staticDraws.assign(mSlots.size(), 0);
+        mStats.dynamicDraws.assign(mSlots.size(), 0);
+        bool dynamic = std::any_of(casters.begin(), casters.end(),
+                                   [](ShadowCaster const & c) { return c.dynamic; });
+
+        mShader->activate();
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_SCISSOR_TEST);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+        for (std::size_t i = 0; i < mSlots.size(); i++)
+        {
+            Slot & slot = mSlots[i];
+            if (slot.rect.z == 0) continue;
+
+            // Redraw Stale Static Depth, Restore it, Then Layer Dynamic Casters on Top
+            if (slot.refresh) draw(mFramebuffers[1], slot, true, casters, false, mStats.staticDraws[i]);
+            if (slot.refresh || slot.dirty || dynamic)
+                glCopyImageSubData(mStatic, GL_TEXTURE_2D, 0, slot.rect.x, slot.rect.y, 0,
+                                   mAtlas,  GL_TEXTURE_2D, 0, slot.rect.x, slot.rect.y, 0,
+                                   slot.rect.z, slot.rect.z, 1);
+            if (dynamic) draw(mFramebuffers[0], slot, false, casters, true, mStats.dynamicDraws[i]);
+            slot.dirty = dynamic;
+            slot.refresh = false;
+        }
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glDisable(GL_SCISSOR_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, previous);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+    void Shadows::draw(GLuint framebuffer, Slot const & slot, bool clear,
+                       std::vector<ShadowCaster> const & casters, bool dynamic,
+                       unsigned int & draws)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glViewport(slot.rect.x, slot.rect.y, slot.rect.z, slot.rect.z);
+        glScissor (slot.rect.x, slot.rect.y, slot.rect.z, slot.rect.z);
+        if (clear) glClear(GL_DEPTH_BUFFER_BIT);
+        mShader->bind("viewProjection", slot.viewProjection);
+        for (auto & caster : casters)
+        {
+            if (caster.dynamic != dynamic) continue;
+            mShader->bind("model", caster.model);
+            draws += caster.mesh->depth();
+        }
+    }
+
+    void Shadows::bind(GLuint shader, GLuint unit)
+    {
+        // Fold the Tile Placement into Each Matrix so Lookups Land in the Atlas; Views Past
+        // What the Shader Holds are Left Out
+        std::vector<glm::mat4> matrices;
+        for (std::size_t i = 0; i < std::min(mSlots.size(), kMaxViews); i++)
+        {   Slot const & slot = mSlots[i];
+            float scale = static_cast<float>(slot.rect.z) / mSize;
+            glm::mat4 tile(glm::vec4(0.5f * scale, 0.0f, 0.0f, 0.0f),
+                           glm::vec4(0.0f, 0.5f * scale, 0.0f, 0.0f),
+                           glm::vec4(0.0f, 0.0f, 0.5f, 0.0f),
+                           glm::vec4(static_cast<float>(slot.rect.x) / mSize + 0.5f * scale,
+                                     static_cast<float>(slot.rect.y) / mSize + 0.5f * scale,
+                                     0.5f, 1.0f));
+            matrices.push_back(tile * slot.viewProjection);
+        }
+
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, mAtlas);
+        glUniform1i(glGetUniformLocation(shader, "shadowAtlas"), unit);
+        glUniform1i(glGetUniformLocation(shader, "shadowCount"), matrices.size());
+        if (!matrices.empty())
+            glUniformMatrix4fv(glGetUniformLocation(shader, "shadowMatrices"),
+                               matrices.size(), GL_FALSE, & matrices[0][0][0]);
+    }
+
+    void Shadows::invalidate()
+    {
+        for (auto & slot : mSlots) slot.valid = false;
+    }
+
+    bool Shadows::allocate(int size, glm::ivec4 & rect)
+    {
+        // Find the Smallest Free Square Large Enough, Splitting it Down to Size
+        int level = 0;
+        while ((mSize >> level) > size) level++;
+        int source = level;
+        while (source >= 0 && mFree[source].empty()) source--;
+        if (source < 0) return false;
+
+        auto block = *mFree[source].begin();
+        mFree[source].erase(mFree[source].begin());
+        for (; source < level; source++)
+        {
+            int half = mSize >> (source + 1);
+            mFree[source + 1].insert(std::make_pair(block.first + half, block.second));
+            mFree[source + 1].insert(std::make_pair(block.first, block.second + half));
+            mFree[source + 1].insert(std::make_pair(block.first + half, block.second + half));
+        }
+        rect = glm::ivec4(block.first, block.second, size, level);
+        return true;
+    }
+
+    void Shadows::release(glm::ivec4 const & rect)
+    {
+        // Merge with Free Siblings for as Long as Possible
+        int x = rect.x, y = rect.y, level = rect.w;
+        for (; level > 0; level--)
+        {
+            int size = mSize >> level;
+            int px = x / (2 * size) * (2 * size), py = y / (2 * size) * (2 * size);
+            std::pair<int, int> siblings[4] = {
+                std::make_pair(px, py),        std::make_pair(px + size, py),
+                std::make_pair(px, py + size), std::make_pair(px + size, py + size) };
+            bool merge = true;
+            for (auto & sibling : siblings)
+                if (sibling != std::make_pair(x, y) && !mFree[level].count(sibling)) merge = false;
+            if (!merge) break;
+            for (auto & sibling : siblings) mFree[level].erase(sibling);
+            x = px; y = py;
+        }
+        mFree[level].insert(std::make_pair(x, y));
+    }
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+// Local Headers
+#include "mesh.hpp"
+#include "shader.hpp"
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Something That Casts a Shadow; Static Casters are Cached Across Frames
+    struct ShadowCaster {
+        Mesh *    mesh;
+        glm::mat4 model;
+        bool      dynamic;
+    };
+
+    // Per-Frame Report
+    struct ShadowStats {
+        float utilization;                       // Fraction of the Atlas Allocated
+        unsigned int cached;                     // Views Whose Static Depth Was Reused
+        std::vector<unsigned int> staticDraws;   // Indexed by View
+        std::vector<unsigned int> dynamicDraws;
+    };
+
+    class Shadows
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor; size Must be a Power of Two of at
+        // Least 128, and Other Sizes are Rounded Down to One and Reported. GL Objects are
+        // Created on the First render(), so Declaring Views Needs No Context
+         Shadows(int size = 4096);
+        ~Shadows();
+
+        // Declare Views in the Same Order Every Frame; Returns the View Index
+        void begin();
+        int  cascade(glm::vec3 const & direction, glm::mat4 const & view,
+                     float fov, float aspect, float near, float far,
+                     int index, int count, int resolution);
+        int  point(glm::vec3 const & position, float radius, int face, int resolution);
+
+        // Free Tiles of Views Not Declared Since begin() and Decide Which Views Reuse their
+        // Cached Static Depth; render() Does This Itself When it Was Not Called
+        void end();
+
+        // Render Every Declared View into the Atlas
+        void render(std::vector<ShadowCaster> const & casters);
+
+        // Upload Atlas-Space Matrices and Bind the Atlas to a Texture Unit
+        void bind(GLuint shader, GLuint unit);
+
+        // Force Static Casters to be Redrawn, e.g. After Loading a Level
+        void invalidate();
+
+        // Public Accessors
+        ShadowStats const & stats() const { return mStats; }
+        GLuint texture() const { return mAtlas; }
+        glm::ivec4 const & tile(int view) const { return mSlots[view].rect; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Shadows(Shadows const &) = delete;
+        Shadows & operator=(Shadows const &) = delete;
+
+        // Persistent State of a Single View
+        struct Slot {
+            glm::mat4  viewProjection;
+            glm::ivec4 rect;       // x, y, size, level
+            bool       valid;      // Static Depth in mStatic Matches viewProjection
+            bool       refresh;    // Static Depth Must be Redrawn This Frame
+            bool       dirty;      // Atlas Holds Dynamic Depth from Last Frame
+        };
+
+        // Private Member Functions
+        void create();
+        int  declare(glm::mat4 const & viewProjection, int resolution);
+        bool allocate(int size, glm::ivec4 & rect);
+        void release(glm::ivec4 const & rect);
+        void draw(GLuint framebuffer, Slot const & slot, bool clear,
+                  std::vector<ShadowCaster> const & casters, bool dynamic,
+                  unsigned int & draws);
+
+        // Buddy Allocator: Free Squares per Level, Level 0 is the Whole Atlas
+        std::vector<std::set<std::pair<int, int>>> mFree;
+
+        // Private Member Containers
+        std::vector<Slot> mSlots;
+        ShadowStats mStats;
+
+        // Private Member Variables
+        std::unique_ptr<Shader> mShader;
+        int    mSize;
+        int    mDeclared;
+        bool   mEnded;
+        GLuint mAtlas;
+        GLuint mStatic;
+        GLuint mFramebuffers[2];
+
+    };
+};
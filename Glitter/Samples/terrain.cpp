@@ -0,0 +1,487 @@
+// Local Headers
+#include "mapping.hpp"
+#include "terrain.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+// Define Namespace
+namespace Mirage
+{
+    // Define Some Constants
+    static const std::uint32_t kVersion = 1;
+    static const std::uint32_t kLevels  = 16;     // Deepest Quadtree a Node Key Can Address
+    static const std::size_t   kPending = 32;     // Chunks Queued or Being Built at Once
+    static const float         kDetail  = 3.0f;   // Below This, Neighbours Can Differ by Two Levels
+    static const float         kMorph   = 0.7f;   // Fraction of a Level's Range Before Morphing Starts
+    static const float         kSkirt   = 4.0f;   // Skirt Depth in Sample Spacings
+    static const std::uint64_t kEmpty   = ~0ull;
+
+    // Relative Names Live in Mirage/Terrain; Absolute Paths, Such as Scratch Files, are Kept
+    static bool absolute(std::string const & filename)
+    {
+        return !filename.empty() && (filename[0] == '/' || filename[0] == '\\' || filename.find(':') == 1);
+    }
+
+    static std::string locate(std::string const & filename)
+    {
+        return absolute(filename) ? filename : PROJECT_SOURCE_DIR "/Mirage/Terrain/" + filename;
+    }
+
+    // Grid Index of the k-th Vertex Along a Side of a Chunk with n Samples per Edge
+    static std::size_t edge(std::size_t n, int side, std::size_t k)
+    {
+        switch (side)
+        {
+            case 0:  return k;
+            case 1:  return k * n + n - 1;
+            case 2:  return (n - 1) * n + k;
+            default: return k * n;
+        }
+    }
+
+    Terrain::Terrain(std::string const & filename, unsigned int slots, unsigned int threads)
+        : mAddress(nullptr)
+        , mLength(0)
+        , mHeader(nullptr)
+        , mBounds(nullptr)
+        , mTiles(nullptr)
+        , mSize(0.0f)
+        , mVertices(0)
+        , mIndices(0)
+        , mVertexArray(0)
+        , mVertexBuffer(0)
+        , mElementBuffer(0)
+        , mCamera(0.0f)
+        , mDetail(kDetail)
+        , mFrame(0)
+        , mStats()
+        , mQuit(false)
+    {
+        // Map the Whole File; Only Tiles Near the Camera are Ever Paged In
+        std::string path = locate(filename);
+        mAddress = mapFile(path, mLength, true);
+        if (!mAddress) { fprintf(stderr, "%s %s\n", "Failed to Map Terrain", path.c_str()); return; }
+
+        // Validate the Header and Check Every Tile is Present
+        auto header = static_cast<TerrainHeader const *>(mAddress);
+        bool valid = mLength >= sizeof(TerrainHeader)
+                  && std::memcmp(header->magic, "MRGT", 4) == 0
+                  && header->version == kVersion
+                  && header->tileSize >= 2 && header->tileSize % 2 == 0
+                  && header->levels >= 1 && header->levels <= kLevels;
+        std::uint64_t samples = valid ? (header->tileSize + 1ull) * (header->tileSize + 1ull) : 0;
+        std::uint64_t tiles   = valid ? first(header->levels) : 0;
+        if (!valid || mLength < sizeof(TerrainHeader) + tiles * (sizeof(TerrainBounds)
+                                                               + samples * sizeof(std::uint16_t)))
+        {
+            fprintf(stderr, "%s %s\n", "Invalid Terrain", path.c_str());
+            unmap();
+            return;
+        }
+        mHeader = header;
+        mBounds = reinterpret_cast<TerrainBounds const *>(header + 1);
+        mTiles  = reinterpret_cast<std::uint16_t const *>(mBounds + tiles);
+        mSize   = mHeader->tileSize * mHeader->spacing * static_cast<float>(1u << (mHeader->levels - 1));
+        std::size_t n = mHeader->tileSize + 1;
+        mVertices = n * n + 4 * n;
+        mSlots.assign(std::max(slots, 1u), Slot { kEmpty, 0, false });
+
+        // The Render Thread Never Builds Chunks, so Keep a Core for It
+        for (unsigned int i = 0; i < std::max(threads, 2u) - 1; i++)
+            mThreads.push_back(std::thread(& Terrain::work, this));
+    }
+
+    Terrain::~Terrain()
+    {
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }   mWork.notify_all();
+        for (auto & thread : mThreads) thread.join();
+        if (mVertexArray) glDeleteVertexArrays(1, & mVertexArray);
+        if (mVertexBuffer) glDeleteBuffers(1, & mVertexBuffer);
+        if (mElementBuffer) glDeleteBuffers(1, & mElementBuffer);
+        unmap();
+    }
+
+    std::uint64_t Terrain::first(std::uint32_t level)
+    {
+        return ((1ull << (2 * level)) - 1) / 3;
+    }
+
+    void Terrain::create()
+    {
+        // Every Chunk Shares One Topology: a Grid, Then a Skirt Hanging from Each Side
+        std::size_t n = mHeader->tileSize + 1;
+        std::vector<GLuint> indices;
+        for (std::size_t j = 0; j + 1 < n; j++)
+        for (std::size_t i = 0; i + 1 < n; i++)
+        {
+            // Diagonals Match the Parent Level's, so Fully Morphed Quads Collapse onto It
+            GLuint a = static_cast<GLuint>(j * n + i), b = a + 1;
+            GLuint c = static_cast<GLuint>(a + n),     d = c + 1;
+            indices.insert(indices.end(), { a, c, d, a, d, b });
+        }
+        for (int side = 0; side < 4; side++)
+        for (std::size_t k = 0; k + 1 < n; k++)
+        {
+            GLuint a = static_cast<GLuint>(edge(n, side, k)), b = static_cast<GLuint>(edge(n, side, k + 1));
+            GLuint c = static_cast<GLuint>(n * n + side * n + k), d = c + 1;
+            indices.insert(indices.end(), { a, c, d, a, d, b });
+        }
+        mIndices = static_cast<GLsizei>(indices.size());
+
+        // Allocate Every Slot Up Front; Memory Never Grows with the World
+        glGenVertexArrays(1, & mVertexArray);
+        glGenBuffers(1, & mVertexBuffer);
+        glGenBuffers(1, & mElementBuffer);
+        glBindVertexArray(mVertexArray);
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, mSlots.size() * mVertices * sizeof(TerrainVertex), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (GLvoid *) offsetof(TerrainVertex, grid));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (GLvoid *) offsetof(TerrainVertex, height));
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (GLvoid *) offsetof(TerrainVertex, normal));
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+        glBindVertexArray(0);
+
+        // The Root Stays Resident so There is Always Something to Fall Back To
+        Node root = { 0, 0, 0 };
+        std::vector<TerrainVertex> vertices;
+        build(root, vertices);
+        upload(root, vertices);
+        mSlots[slot(root)].pinned = true;
+    }
+
+    bool Terrain::bake(std::string const & filename, TerrainHeader const & layout,
+                       std::function<float(float x, float z)> const & height)
+    {
+        if (layout.tileSize < 2 || layout.tileSize % 2 || layout.levels < 1
+            || layout.levels > kLevels || layout.scale <= 0.0f)
+        {   fprintf(stderr, "%s %s\n", "Invalid Terrain Layout", filename.c_str());
+            return false;
+        }
+
+        // Write the Header Where the Constructor Will Look, Then Reserve the Bounds Table
+        if (!absolute(filename)) makeDirectory(PROJECT_SOURCE_DIR "/Mirage/Terrain");
+        std::string path = locate(filename);
+        std::ofstream fd(path, std::ios::binary);
+        if (!fd) { fprintf(stderr, "%s %s\n", "Failed to Write Terrain", path.c_str()); return false; }
+        TerrainHeader header = layout;
+        std::memcpy(header.magic, "MRGT", 4);
+        header.version  = kVersion;
+        header.reserved = 0;
+        fd.write(reinterpret_cast<char const *>(& header), sizeof(header));
+        std::vector<TerrainBounds> zero(4096, TerrainBounds());
+        for (std::uint64_t remaining = first(header.levels); remaining > 0;)
+        {   std::uint64_t count = std::min<std::uint64_t>(remaining, zero.size());
+            fd.write(reinterpret_cast<char const *>(zero.data()), count * sizeof(TerrainBounds));
+            remaining -= count;
+        }
+
+        // Sample Each Level at its Own Spacing; Coarse Samples Land on Fine Ones Exactly
+        std::uint32_t n = header.tileSize + 1;
+        std::vector<std::uint16_t> samples(n * n);
+        std::uint64_t bounds = sizeof(TerrainHeader);
+        std::uint64_t tiles  = bounds + first(header.levels) * sizeof(TerrainBounds);
+        for (std::uint32_t level = 0; level < header.levels; level++)
+        {
+            float step = header.spacing * static_cast<float>(1u << (header.levels - 1 - level));
+            for (std::uint32_t y = 0; y < (1u << level); y++)
+            for (std::uint32_t x = 0; x < (1u << level); x++)
+            {
+                TerrainBounds range = { 0xFFFF, 0 };
+                for (std::uint32_t j = 0; j < n; j++)
+                for (std::uint32_t i = 0; i < n; i++)
+                {
+                    float h = height((x * header.tileSize + i) * step, (y * header.tileSize + j) * step);
+                    float q = std::round((h - header.low) / header.scale);
+                    auto sample = static_cast<std::uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+                    samples[j * n + i] = sample;
+                    range.low  = std::min(range.low,  sample);
+                    range.high = std::max(range.high, sample);
+                }
+                std::uint64_t index = first(level) + (static_cast<std::uint64_t>(y) << level) + x;
+                fd.seekp(bounds + index * sizeof(TerrainBounds));
+                fd.write(reinterpret_cast<char const *>(& range), sizeof(range));
+                fd.seekp(tiles + index * samples.size() * sizeof(std::uint16_t));
+                fd.write(reinterpret_cast<char const *>(samples.data()), samples.size() * sizeof(std::uint16_t));
+            }
+        }   return static_cast<bool>(fd);
+    }
+
+    void Terrain::update(glm::mat4 const & view, glm::mat4 const & projection, float detail)
+    {
+        mFrame++;
+        mStats = TerrainStats();
+        if (!mHeader) return;
+        if (!mVertexArray) create();
+        mDetail = std::max(detail, kDetail);
+        mCamera = glm::vec3(glm::inverse(view)[3]);
+
+        // Frustum Planes from the Rows of the View-Projection Matrix
+        glm::mat4 clip = projection * view;
+        for (int i = 0; i < 3; i++)
+        {   glm::vec4 row(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+            glm::vec4 w(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+            mPlanes[2 * i]     = w + row;
+            mPlanes[2 * i + 1] = w - row;
+        }
+
+        // Choose Chunks, Falling Back to Resident Ancestors While Children Stream In
+        mDraws.clear();
+        mWants.clear();
+        select(Node { 0, 0, 0 }, mCamera, mDetail);
+
+        // Copy Chunks Finished Since the Last Update into Slots Not Selected Above;
+        // They are Drawn from the Next Update On
+        std::vector<Result> done;
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            done.swap(mDone);
+            for (auto & result : done) mPending.erase(key(result.node));
+        }
+        for (auto & result : done) upload(result.node, result.vertices);
+
+        // Only Request What Can Land in a Slot Not Selected Above
+        std::size_t available = 0;
+        for (auto & slot : mSlots) available += slot.lastUsed != mFrame && !slot.pinned;
+
+        // Replace Whatever Has Not Started Yet: Coarse Levels First, Then Nearest First
+        std::sort(mWants.begin(), mWants.end(), [](Want const & a, Want const & b)
+                  { return a.node.level != b.node.level ? a.node.level < b.node.level
+                                                        : a.distance < b.distance; });
+        {   std::lock_guard<std::mutex> lock(mMutex);
+            for (auto & node : mQueue) mPending.erase(key(node));
+            mQueue.clear();
+            for (auto & want : mWants)
+            {   if (mPending.size() >= std::min(kPending, available)) break;
+                if (slot(want.node) < 0 && mPending.insert(key(want.node)).second)
+                    mQueue.push_back(want.node);
+            }
+            mStats.pending = static_cast<unsigned int>(mPending.size());
+        }   mWork.notify_all();
+        mStats.drawn    = static_cast<unsigned int>(mDraws.size());
+        mStats.resident = static_cast<unsigned int>(mResident.size());
+    }
+
+    void Terrain::draw(GLuint shader)
+    {
+        if (mDraws.empty()) return;
+        GLint chunk  = glGetUniformLocation(shader, "chunk");
+        GLint morph  = glGetUniformLocation(shader, "morph");
+        glUniform3fv(glGetUniformLocation(shader, "camera"), 1, & mCamera[0]);
+        glBindVertexArray(mVertexArray);
+        for (auto & draw : mDraws)
+        {
+            // Morph to the Parent's Grid Over the Last Part of this Level's Range, so
+            // Vertices are Fully Morphed Wherever a Coarser Neighbour Can Begin
+            auto & node = draw.node;
+            float spacing = step(node.level);
+            float range   = mDetail * mHeader->tileSize * spacing;
+            glUniform3f(chunk, node.x * mHeader->tileSize * spacing, node.y * mHeader->tileSize * spacing, spacing);
+            if (node.level == 0) glUniform2f(morph, std::numeric_limits<float>::max(), 1.0f);
+            else glUniform2f(morph, kMorph * range, 1.0f / ((1.0f - kMorph) * range));
+            glDrawElementsBaseVertex(GL_TRIANGLES, mIndices, GL_UNSIGNED_INT, nullptr,
+                                     static_cast<GLint>(draw.slot * mVertices));
+        }
+        glBindVertexArray(0);
+    }
+
+    float Terrain::height(float x, float z) const
+    {
+        if (!mHeader) return 0.0f;
+        float u = x / mHeader->spacing, v = z / mHeader->spacing;
+        float i = std::floor(u), j = std::floor(v);
+        auto gx = static_cast<std::int64_t>(i), gz = static_cast<std::int64_t>(j);
+        std::uint32_t level = mHeader->levels - 1;
+        float a = sample(level, gx, gz),     b = sample(level, gx + 1, gz);
+        float c = sample(level, gx, gz + 1), d = sample(level, gx + 1, gz + 1);
+        float s = u - i, t = v - j;
+        return (a * (1.0f - s) + b * s) * (1.0f - t) + (c * (1.0f - s) + d * s) * t;
+    }
+
+    void Terrain::chunk(std::uint32_t level, std::uint32_t x, std::uint32_t y,
+                        std::vector<TerrainVertex> & vertices) const
+    {
+        if (!mHeader) { vertices.clear(); return; }
+        build(Node { level, x, y }, vertices);
+    }
+
+    void Terrain::unmap()
+    {
+        if (!mAddress) return;
+        unmapFile(mAddress, mLength);
+        mAddress = nullptr;
+        mHeader  = nullptr;
+        mBounds  = nullptr;
+        mTiles   = nullptr;
+    }
+
+    void Terrain::work()
+    {
+        for (;;)
+        {
+            Result result;
+            {   std::unique_lock<std::mutex> lock(mMutex);
+                mWork.wait(lock, [this] { return mQuit || !mQueue.empty(); });
+                if (mQuit) return;
+                result.node = mQueue.front();
+                mQueue.pop_front();
+            }
+
+            build(result.node, result.vertices);
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDone.push_back(std::move(result));
+        }
+    }
+
+    void Terrain::build(Node const & node, std::vector<TerrainVertex> & vertices) const
+    {
+        std::size_t n = mHeader->tileSize + 1;
+        float spacing = step(node.level);
+        std::int64_t x0 = static_cast<std::int64_t>(node.x) * mHeader->tileSize;
+        std::int64_t z0 = static_cast<std::int64_t>(node.y) * mHeader->tileSize;
+        vertices.resize(mVertices);
+
+        // Normals from Central Differences, Reading Across Tile Edges so Seams Shade Alike
+        for (std::size_t j = 0; j < n; j++)
+        for (std::size_t i = 0; i < n; i++)
+        {
+            std::int64_t x = x0 + i, z = z0 + j;
+            auto & vertex = vertices[j * n + i];
+            vertex.grid   = glm::vec2(i, j);
+            vertex.height = sample(node.level, x, z);
+            vertex.coarse = node.level == 0 ? vertex.height
+                          : sample(node.level, x0 + (i & ~std::size_t(1)), z0 + (j & ~std::size_t(1)));
+            vertex.normal = glm::normalize(glm::vec3(
+                sample(node.level, x - 1, z) - sample(node.level, x + 1, z), 2.0f * spacing,
+                sample(node.level, x, z - 1) - sample(node.level, x, z + 1)));
+            vertex.reserved = 0.0f;
+        }
+
+        // Skirts Hide Any Gap Left While a Neighbour is Still Streaming In
+        for (int side = 0; side < 4; side++)
+        for (std::size_t k = 0; k < n; k++)
+        {
+            auto & skirt = vertices[n * n + side * n + k];
+            skirt = vertices[edge(n, side, k)];
+            skirt.height -= kSkirt * spacing;
+            skirt.coarse -= kSkirt * spacing;
+        }
+    }
+
+    void Terrain::select(Node const & node, glm::vec3 const & camera, float detail)
+    {
+        // Everything Selected is Resident, Including the Ancestors of Drawn Chunks
+        mSlots[slot(node)].lastUsed = mFrame;
+        glm::vec3 nearest = glm::clamp(camera, lower(node), upper(node));
+        if (node.level + 1 < mHeader->levels
+            && glm::distance(camera, nearest) < detail * mHeader->tileSize * step(node.level + 1))
+        {
+            bool ready = true;
+            Node children[4];
+            for (std::uint32_t i = 0; i < 4; i++)
+            {
+                children[i] = Node { node.level + 1, node.x * 2 + (i & 1), node.y * 2 + (i >> 1) };
+                if (slot(children[i]) >= 0) continue;
+                glm::vec3 closest = glm::clamp(camera, lower(children[i]), upper(children[i]));
+                mWants.push_back(Want { children[i], glm::distance(camera, closest) });
+                ready = false;
+            }
+
+            // Split Only Once All Four Children Can Replace this Node
+            if (ready)
+            {   for (auto & child : children) select(child, camera, detail);
+                return;
+            }
+        }
+        if (visible(node)) mDraws.push_back(Draw { node, slot(node) });
+    }
+
+    void Terrain::upload(Node const & node, std::vector<TerrainVertex> const & vertices)
+    {
+        // Take an Empty Slot, Otherwise the Least Recently Used One Not Selected this Update
+        int victim = -1;
+        for (std::size_t i = 0; i < mSlots.size(); i++)
+        {
+            auto & slot = mSlots[i];
+            if (slot.key == kEmpty) { victim = static_cast<int>(i); break; }
+            if (slot.pinned || slot.lastUsed == mFrame) continue;
+            if (victim < 0 || slot.lastUsed < mSlots[victim].lastUsed) victim = static_cast<int>(i);
+        }
+        if (victim < 0) { mStats.dropped++; return; }
+        if (mSlots[victim].key != kEmpty) mResident.erase(mSlots[victim].key);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, victim * mVertices * sizeof(TerrainVertex),
+                        mVertices * sizeof(TerrainVertex), vertices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mSlots[victim] = Slot { key(node), mFrame, false };
+        mResident[key(node)] = victim;
+        mStats.uploaded++;
+    }
+
+    int Terrain::slot(Node const & node) const
+    {
+        auto found = mResident.find(key(node));
+        return found == mResident.end() ? -1 : found->second;
+    }
+
+    bool Terrain::visible(Node const & node) const
+    {
+        // Test the Corner Furthest Along Each Plane's Normal
+        glm::vec3 low = lower(node), high = upper(node);
+        for (auto & plane : mPlanes)
+        {   glm::vec3 corner(plane.x > 0.0f ? high.x : low.x,
+                             plane.y > 0.0f ? high.y : low.y,
+                             plane.z > 0.0f ? high.z : low.z);
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) return false;
+        }   return true;
+    }
+
+    glm::vec3 Terrain::lower(Node const & node) const
+    {
+        float size = mSize / static_cast<float>(1u << node.level);
+        auto & bounds = mBounds[first(node.level) + (static_cast<std::uint64_t>(node.y) << node.level) + node.x];
+        float skirt = kSkirt * step(node.level);
+        return glm::vec3(node.x * size, mHeader->low + mHeader->scale * bounds.low - skirt, node.y * size);
+    }
+
+    glm::vec3 Terrain::upper(Node const & node) const
+    {
+        float size = mSize / static_cast<float>(1u << node.level);
+        auto & bounds = mBounds[first(node.level) + (static_cast<std::uint64_t>(node.y) << node.level) + node.x];
+        return glm::vec3((node.x + 1) * size, mHeader->low + mHeader->scale * bounds.high, (node.y + 1) * size);
+    }
+
+    float Terrain::step(std::uint32_t level) const
+    {
+        return mHeader->spacing * static_cast<float>(1u << (mHeader->levels - 1 - level));
+    }
+
+    float Terrain::sample(std::uint32_t level, std::int64_t x, std::int64_t z) const
+    {
+        // Clamp to the World Edge, Then Find the Tile; Shared Edges Exist in Both Tiles
+        std::int64_t tiles = 1ll << level, size = mHeader->tileSize;
+        x = std::min(std::max(x, std::int64_t(0)), tiles * size);
+        z = std::min(std::max(z, std::int64_t(0)), tiles * size);
+        std::int64_t tx = std::min(x / size, tiles - 1), tz = std::min(z / size, tiles - 1);
+        std::uint64_t n = size + 1, index = first(level) + tz * tiles + tx;
+        std::uint16_t value = mTiles[index * n * n + (z - tz * size) * n + (x - tx * size)];
+        return mHeader->low + mHeader->scale * value;
+    }
+
+    std::uint64_t Terrain::key(Node const & node)
+    {
+        return (static_cast<std::uint64_t>(node.level) << 56)
+             | (static_cast<std::uint64_t>(node.y) << 28) | node.x;
+    }
+};
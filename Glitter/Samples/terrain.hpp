@@ -0,0 +1,183 @@
+#pragma once
+
+// System Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Standard Headers
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Define Namespace
+namespace Mirage
+{
+    // Terrain File Format: the Header is Followed by a Table of Per-Tile Height Bounds, Then
+    // the Tiles Themselves. Level 0 is One Tile Covering the World; Level L Has 2^L by 2^L
+    // Tiles, Each Holding (tileSize + 1)^2 Row-Major 16-Bit Samples Shared Along its Edges
+    struct TerrainHeader {
+        char          magic[4];  // Always "MRGT"
+        std::uint32_t version;
+        std::uint32_t tileSize;  // Quads per Tile Edge; Must be Even
+        std::uint32_t levels;
+        float         spacing;   // World Units Between Samples of the Finest Level
+        float         low;       // Height of Sample Zero
+        float         scale;     // Height per Sample Step
+        std::uint32_t reserved;
+    };
+
+    // Lowest and Highest Sample of a Tile, for Selection and Culling
+    struct TerrainBounds {
+        std::uint16_t low;
+        std::uint16_t high;
+    };
+
+    // Chunk Vertex Format: Grid Coordinates are in Quads so the Shader Can Snap Them Exactly
+    struct TerrainVertex {
+        glm::vec2 grid;
+        float     height;
+        float     coarse;    // Height at the Parent Level's Grid Point this Vertex Morphs To
+        glm::vec3 normal;
+        float     reserved;
+    };
+
+    // Streaming Counters for the Last Update
+    struct TerrainStats {
+        unsigned int drawn;     // Chunks in the Draw List
+        unsigned int resident;  // Chunk Slots Holding Geometry
+        unsigned int pending;   // Chunks Queued or Being Built
+        unsigned int uploaded;  // Chunks Copied to the GPU this Update
+        unsigned int dropped;   // Finished Chunks Discarded for Lack of a Free Slot
+    };
+
+    class Terrain
+    {
+    public:
+
+        // Implement Custom Constructor and Destructor. Names are Looked Up in Mirage/Terrain
+        // Unless They are Absolute Paths; GL Objects are Created on the First Update
+         Terrain(std::string const & filename, unsigned int slots = 256,
+                 unsigned int threads = std::thread::hardware_concurrency());
+        ~Terrain();
+
+        // Write a Terrain File by Sampling a Height Function Tile by Tile, so Arbitrarily
+        // Large Worlds Bake in Constant Memory. Magic and Version are Filled In, and the
+        // File Lands Where the Constructor Looks for It
+        static bool bake(std::string const & filename, TerrainHeader const & layout,
+                         std::function<float(float x, float z)> const & height);
+
+        // Upload Finished Chunks, Choose Chunks Around the Camera and Queue Missing Ones.
+        // A Node Splits When the Camera is Within detail Times its Children's Size
+        void update(glm::mat4 const & view, glm::mat4 const & projection, float detail = 4.0f);
+
+        // Draw the Chunks Chosen by the Last Update with terrain.vert. The Shader Must
+        // Already Have its View and Projection Uniforms Set
+        void draw(GLuint shader);
+
+        // Bilinear Height of the Finest Level at a World Position
+        float height(float x, float z) const;
+
+        // Vertices of One Chunk as the Streaming Threads Build Them: the Grid Row by Row,
+        // Then tileSize + 1 Skirt Vertices per Side
+        void chunk(std::uint32_t level, std::uint32_t x, std::uint32_t y,
+                   std::vector<TerrainVertex> & vertices) const;
+
+        // Tiles Stored Before a Level, Coarsest First, so Also the Tile Count of a File
+        static std::uint64_t first(std::uint32_t level);
+
+        // Public Accessors
+        float size() const { return mSize; }
+        TerrainStats const & stats() const { return mStats; }
+
+    private:
+
+        // Disable Copying and Assignment
+        Terrain(Terrain const &) = delete;
+        Terrain & operator=(Terrain const &) = delete;
+
+        // Private Data Types
+        struct Node {
+            std::uint32_t level, x, y;
+        };
+
+        struct Slot {
+            std::uint64_t key;
+            std::uint64_t lastUsed;
+            bool          pinned;
+        };
+
+        struct Draw {
+            Node node;
+            int  slot;
+        };
+
+        struct Want {
+            Node  node;
+            float distance;
+        };
+
+        struct Result {
+            Node node;
+            std::vector<TerrainVertex> vertices;
+        };
+
+        // Private Member Functions
+        void create();
+        void unmap();
+        void work();
+        void build(Node const & node, std::vector<TerrainVertex> & vertices) const;
+        void select(Node const & node, glm::vec3 const & camera, float detail);
+        void upload(Node const & node, std::vector<TerrainVertex> const & vertices);
+        int  slot(Node const & node) const;
+        bool visible(Node const & node) const;
+        glm::vec3 lower(Node const & node) const;
+        glm::vec3 upper(Node const & node) const;
+        float step(std::uint32_t level) const;
+        float sample(std::uint32_t level, std::int64_t x, std::int64_t z) const;
+        static std::uint64_t key(Node const & node);
+
+        // Memory-Mapped Terrain File
+        void * mAddress;
+        std::size_t mLength;
+        TerrainHeader const * mHeader;
+        TerrainBounds const * mBounds;
+        std::uint16_t const * mTiles;
+        float mSize;
+
+        // Fixed Pool of Chunk Slots in One Vertex Buffer, Sharing One Index Buffer
+        std::vector<Slot> mSlots;
+        std::unordered_map<std::uint64_t, int> mResident;
+        std::size_t mVertices;
+        GLsizei mIndices;
+        GLuint  mVertexArray;
+        GLuint  mVertexBuffer;
+        GLuint  mElementBuffer;
+
+        // Selection State, Reused Every Update
+        std::vector<Draw> mDraws;
+        std::vector<Want> mWants;
+        glm::vec4 mPlanes[6];
+        glm::vec3 mCamera;
+        float mDetail;
+        std::uint64_t mFrame;
+        TerrainStats mStats;
+
+        // Background Chunk Builders
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mWork;
+        std::deque<Node> mQueue;
+        std::vector<Result> mDone;
+        std::unordered_set<std::uint64_t> mPending;
+        bool mQuit;
+
+    };
+};